@@ -23,13 +23,25 @@
 #include <stdlib.h>
 #include <check.h>
 
+#include "config.h"
+#ifdef HAVE_MPI_H
+#include <mpi.h>
+#endif
+
 #include "check_escdf.h"
 
-int main(void)
+int main(int argc, char **argv)
 {
     int number_failed;
     SRunner *sr;
 
+#ifdef HAVE_MPI
+    MPI_Init(&argc, &argv);
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     sr = srunner_create(make_info_suite());
 
     srunner_add_suite(sr, make_error_suite());
@@ -51,9 +63,10 @@ int main(void)
 
     /*
     srunner_add_suite(sr, make_system_suite());
-    srunner_add_suite(sr, make_grid_scalarfield_suite());
     */
 
+    srunner_add_suite(sr, make_grid_scalarfield_suite());
+
     /* dirty workaround for debian test suite */
 
     srunner_set_fork_status(sr, CK_NOFORK);
@@ -61,5 +74,8 @@ int main(void)
     srunner_run_all(sr, CK_VERBOSE);
     number_failed = srunner_ntests_failed(sr);
     srunner_free(sr);
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
     return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -39,9 +39,6 @@ Suite *make_group_suite(void);
 
 Suite *make_new_group_suite(void);
 
-
-/*
 Suite *make_grid_scalarfield_suite(void);
-*/
 
 #endif
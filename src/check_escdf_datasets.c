@@ -26,10 +26,15 @@
 #include "escdf_datasets.h"
 #include "utils_hdf5.h"
 #include "escdf_handle.h"
+#include "escdf.h"
+#include "escdf_group.h"
+#include "escdf_hl.h"
 
 
 #define FILE_R "check_dataset_test_file_r.h5"
 #define FILE_W "check_dataset_test_file_w.h5"
+#define FILE_HL "check_dataset_test_file_hl.h5"
+#define FILE_MPI "check_dataset_test_file_mpi.h5"
 
 
 #define NONE            0
@@ -44,6 +49,8 @@
 #define ARRAY2_INT      9
 #define ARRAY2_DOUBLE  10
 #define ARRAY2_STRING  11
+#define ROW_LENGTHS    12
+#define ROWS_DOUBLE    13
 
 
 static const escdf_attribute_specs_t specs_dim0 = {
@@ -62,6 +69,14 @@ static const escdf_attribute_specs_t specs_dim2 = {
 
 static const escdf_attribute_specs_t *array2_dims[] = {&specs_dim1, &specs_dim2};
 
+static const escdf_attribute_specs_t *row_lengths_dims[] = {&specs_dim1};
+
+static const escdf_attribute_specs_t specs_row_lengths = {
+    ROW_LENGTHS, "row_lengths", ESCDF_DT_UINT, 0, 1, row_lengths_dims
+};
+
+static const escdf_attribute_specs_t *rows_dims[] = {&specs_dim1, &specs_row_lengths};
+
 static const escdf_dataset_specs_t specs_none = {
     NONE, "none", ESCDF_DT_NONE, 0, 0, false, false, NULL
 };
@@ -98,6 +113,10 @@ static const escdf_dataset_specs_t specs_array2_string = {
     ARRAY2_STRING, "array2_string", ESCDF_DT_STRING, 30, 2, false, true, array2_dims
 };
 
+static const escdf_dataset_specs_t specs_rows_double = {
+    ROWS_DOUBLE, "rows_double", ESCDF_DT_DOUBLE, 0, 2, false, true, rows_dims
+};
+
 static hid_t string_len_30;
 static size_t dims0[] = {4};
 static unsigned int array1_uint[4] = {0, 1, 2, 3};
@@ -115,9 +134,13 @@ static double array2_double[2][3] = {{0.00, 0.00, 0.00},
 static char array2_string[2][3][30] = {{"element1", "element2", "element3"},
                                       {"string", "another string", "yet another string"}};
 
+static unsigned int row_lengths[2] = {2, 3};
+static double rows_double[5] = {0.00, 0.25, 0.50, 0.75, 1.00};
+
 static escdf_handle_t *handle_r = NULL, *handle_w = NULL;
 static escdf_attribute_t *dtset1_dims[1] = {NULL}, *dtset2_dims[2] = {NULL, NULL};
 static escdf_dataset_t *dtset = NULL;
+static escdf_group_t *group = NULL;
 
 
 /******************************************************************************
@@ -216,6 +239,37 @@ void array2_teardown(void)
     dtset2_dims[1] = NULL;
 }
 
+void rows_setup(void)
+{
+    file_setup();
+    dtset2_dims[0] = escdf_attribute_new(&specs_dim1, NULL);
+    escdf_attribute_set(dtset2_dims[0], &dims1[0]);
+    dtset2_dims[1] = escdf_attribute_new(&specs_row_lengths, dtset2_dims);
+    escdf_attribute_set(dtset2_dims[1], row_lengths);
+}
+
+void system_setup(void)
+{
+    unsigned int num_sites = 2;
+
+    escdf_init();
+    handle_w = escdf_create(FILE_HL, NULL);
+    group = escdf_group_create(handle_w, SYSTEM, NULL);
+    escdf_group_attribute_set(group, NUMBER_OF_SITES, &num_sites);
+    escdf_group_attribute_set(group, NUMBER_OF_SPECIES_AT_SITE, row_lengths);
+}
+
+void system_teardown(void)
+{
+    escdf_group_free(group);
+    escdf_close(handle_w);
+    escdf_group_specs_cleanup();
+    unlink(FILE_HL);
+
+    group = NULL;
+    handle_w = NULL;
+}
+
 
 /******************************************************************************
  * Tests                                                                      *
@@ -327,12 +381,289 @@ START_TEST(test_dataset_new_string_array2)
 }
 END_TEST
 
+START_TEST(test_dataset_time_series_double_array1)
+{
+    double frame[4];
+    unsigned int i;
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_set_time_series(dtset, true) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_get_number_of_frames(dtset) == 0);
+
+    for (i = 0; i < 4; i++) {
+        frame[i] = 2. * array1_double[i] + 1.;
+    }
+    ck_assert(escdf_dataset_append_frame(dtset, array1_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_append_frame(dtset, frame) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_get_number_of_frames(dtset) == 2);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_open(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_is_time_series(dtset));
+    ck_assert(escdf_dataset_get_number_of_frames(dtset) == 2);
+    ck_assert(escdf_dataset_read_frame(dtset, 1, frame) == ESCDF_SUCCESS);
+    for (i = 0; i < 4; i++) {
+        ck_assert(frame[i] == 2. * array1_double[i] + 1.);
+    }
+    ck_assert(escdf_dataset_read_frame(dtset, 2, frame) == ESCDF_ERANGE);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_mem_double_array1)
+{
+    /* The values are interleaved with others in memory. */
+    double array[4][2], values[4][2];
+    size_t start[1] = {0}, count[1] = {4};
+    size_t mem_dims[2] = {4, 2}, mem_start[2] = {0, 0}, mem_count[2] = {4, 1};
+    unsigned int i;
+
+    for (i = 0; i < 4; i++) {
+        array[i][0] = array1_double[i];
+        array[i][1] = -1.;
+        values[i][0] = -2.;
+        values[i][1] = -2.;
+    }
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write_mem(dtset, start, count, NULL, array,
+                                      mem_dims, 2, mem_start, mem_count, NULL) == ESCDF_SUCCESS);
+    mem_start[1] = 1;
+    ck_assert(escdf_dataset_read_mem(dtset, start, count, NULL, values,
+                                     mem_dims, 2, mem_start, mem_count, NULL) == ESCDF_SUCCESS);
+    for (i = 0; i < 4; i++) {
+        ck_assert(values[i][0] == -2.);
+        ck_assert(values[i][1] == array1_double[i]);
+    }
+
+    /* Selections of different sizes are rejected. */
+    mem_count[0] = 3;
+    ck_assert(escdf_dataset_read_mem(dtset, start, count, NULL, values,
+                                     mem_dims, 2, mem_start, mem_count, NULL) != ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_boxes_double_array1)
+{
+    double values[3];
+    size_t start[2] = {0, 3}, count[2] = {2, 1};
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write_boxes(dtset, 1, start, dims0, NULL, array1_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read_boxes(dtset, 2, start, count, NULL, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == array1_double[0]);
+    ck_assert(values[1] == array1_double[1]);
+    ck_assert(values[2] == array1_double[3]);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_boxes_double_rows)
+{
+    double values[5];
+    /* Each box covers whole rows of different lengths. */
+    size_t start_rows[4] = {0, 0, 1, 0}, count_rows[4] = {1, 2, 1, 3};
+    /* A box over both rows, from the second column. */
+    size_t start[2] = {0, 1}, count[2] = {2, 1};
+    unsigned int i;
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_rows_double, dtset2_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write_boxes(dtset, 2, start_rows, count_rows, NULL, rows_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read_boxes(dtset, 2, start_rows, count_rows, NULL, values) == ESCDF_SUCCESS);
+    for (i = 0; i < 5; i++) {
+        ck_assert(values[i] == rows_double[i]);
+    }
+    ck_assert(escdf_dataset_read_boxes(dtset, 1, start, count, NULL, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == rows_double[1]);
+    ck_assert(values[1] == rows_double[3]);
+
+    /* The first row is too short for two columns from the second one. */
+    count[1] = 2;
+    ck_assert(escdf_dataset_read_boxes(dtset, 1, start, count, NULL, values) == ESCDF_ERANGE);
+    start[0] = 1;
+    count[0] = 1;
+    ck_assert(escdf_dataset_read_boxes(dtset, 1, start, count, NULL, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == rows_double[3]);
+    ck_assert(values[1] == rows_double[4]);
+    start[0] = 2;
+    ck_assert(escdf_dataset_read_boxes(dtset, 1, start, count, NULL, values) == ESCDF_ERANGE);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_points_double_array1)
+{
+    double values[3];
+    size_t start[1] = {0};
+    size_t coord[3] = {3, 0, 2};
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write(dtset, start, dims0, NULL, array1_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read_points(dtset, 3, coord, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == array1_double[3]);
+    ck_assert(values[1] == array1_double[0]);
+    ck_assert(values[2] == array1_double[2]);
+    coord[1] = 4;
+    ck_assert(escdf_dataset_read_points(dtset, 3, coord, values) == ESCDF_ERANGE);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_points_double_rows)
+{
+    double values[2];
+    size_t start_rows[4] = {0, 0, 1, 0}, count_rows[4] = {1, 2, 1, 3};
+    size_t coord[4] = {1, 2, 0, 1};
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_rows_double, dtset2_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write_boxes(dtset, 2, start_rows, count_rows, NULL, rows_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read_points(dtset, 2, coord, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == rows_double[4]);
+    ck_assert(values[1] == rows_double[1]);
+
+    /* The first row only has two columns. */
+    coord[3] = 2;
+    ck_assert(escdf_dataset_read_points(dtset, 2, coord, values) == ESCDF_ERANGE);
+    /* There is no third row. */
+    coord[2] = 2;
+    coord[3] = 0;
+    ck_assert(escdf_dataset_read_points(dtset, 2, coord, values) == ESCDF_ERANGE);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_hl_dataset_points_species_at_site)
+{
+    unsigned int species[5] = {0, 1, 2, 3, 4}, values[2];
+    size_t start_rows[4] = {0, 0, 1, 0}, count_rows[4] = {1, 2, 1, 3};
+    size_t coord[4] = {1, 1, 0, 1};
+
+    ck_assert( (dtset = escdf_group_dataset_create(group, SPECIES_AT_SITE)) != NULL);
+    ck_assert(escdf_dataset_write_boxes(dtset, 2, start_rows, count_rows, NULL, species) == ESCDF_SUCCESS);
+    ck_assert(escdf_hl_dataset_read_points(group, SPECIES_AT_SITE, 2, coord, values) == ESCDF_SUCCESS);
+    ck_assert(values[0] == species[3]);
+    ck_assert(values[1] == species[1]);
+    coord[2] = 2;
+    ck_assert(escdf_hl_dataset_read_points(group, SPECIES_AT_SITE, 2, coord, values) != ESCDF_SUCCESS);
+}
+END_TEST
+
+START_TEST(test_dataset_transfer_mode_double_array1)
+{
+    double values[4];
+    size_t start[1] = {0}, count[1] = {4};
+    unsigned int i;
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_get_transfer_mode(dtset) == ESCDF_TRANSFER_DEFAULT);
+    ck_assert(escdf_dataset_set_transfer_mode(dtset, ESCDF_N_TRANSFER_MODES) == ESCDF_ERANGE);
+    ck_assert(escdf_dataset_set_transfer_mode(dtset, ESCDF_TRANSFER_COLLECTIVE) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_get_transfer_mode(dtset) == ESCDF_TRANSFER_COLLECTIVE);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write(dtset, start, count, NULL, array1_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read_transfer(dtset, ESCDF_TRANSFER_INDEPENDENT,
+                                          start, count, NULL, values) == ESCDF_SUCCESS);
+    for (i = 0; i < 4; i++) {
+        ck_assert(values[i] == array1_double[i]);
+    }
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_write_aggregated_double_array1)
+{
+    double values[4];
+    size_t start[1] = {0}, count[1] = {4};
+    unsigned int i;
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write_aggregated(dtset, handle_w, start, count, NULL,
+                                             array1_double) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_read(dtset, start, count, NULL, values) == ESCDF_SUCCESS);
+    for (i = 0; i < 4; i++) {
+        ck_assert(values[i] == array1_double[i]);
+    }
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+START_TEST(test_dataset_read_shared_double_array1)
+{
+    escdf_shared_t *shared;
+    const double *values;
+    size_t start[1] = {0}, count[1] = {4};
+    unsigned int i;
+
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_w->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write(dtset, start, count, NULL, array1_double) == ESCDF_SUCCESS);
+    ck_assert( (shared = escdf_dataset_read_shared(dtset, handle_w)) != NULL);
+    ck_assert(escdf_shared_get_size(shared) == 4 * sizeof(double));
+    ck_assert( (values = escdf_shared_get_data(shared)) != NULL);
+    for (i = 0; i < 4; i++) {
+        ck_assert(values[i] == array1_double[i]);
+    }
+    escdf_shared_free(shared);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+}
+END_TEST
+
+#ifdef HAVE_MPI
+START_TEST(test_dataset_read_shared_node_double_array1)
+{
+    escdf_handle_t *handle_m;
+    escdf_shared_t *shared;
+    const double *values;
+    size_t start[1] = {0}, count[1] = {4};
+    unsigned int i;
+
+    ck_assert( (handle_m = escdf_create_mpi(FILE_MPI, NULL, MPI_COMM_WORLD)) != NULL);
+    ck_assert(escdf_handle_set_node_sharing(handle_m, true) == ESCDF_SUCCESS);
+    ck_assert( (dtset = escdf_dataset_new(&specs_array1_double, dtset1_dims)) != NULL);
+    ck_assert(escdf_dataset_create(dtset, handle_m->group_id) == ESCDF_SUCCESS);
+    ck_assert(escdf_dataset_write(dtset, start, count, NULL, array1_double) == ESCDF_SUCCESS);
+    ck_assert( (shared = escdf_dataset_read_shared(dtset, handle_m)) != NULL);
+    ck_assert(escdf_shared_get_size(shared) == 4 * sizeof(double));
+    ck_assert( (values = escdf_shared_get_data(shared)) != NULL);
+    for (i = 0; i < 4; i++) {
+        ck_assert(values[i] == array1_double[i]);
+    }
+    escdf_shared_free(shared);
+    ck_assert(escdf_dataset_close(dtset) == ESCDF_SUCCESS);
+    escdf_dataset_free(dtset);
+    ck_assert(escdf_close(handle_m) == ESCDF_SUCCESS);
+    unlink(FILE_MPI);
+}
+END_TEST
+#endif
+
 
 Suite * make_datasets_suite(void)
 {
     Suite *s;
     TCase *tc_dataset_specs_sizeof, *tc_dataset_specs_is_present, *tc_dataset_specs_disordered_storage_allowed,
-	  *tc_dataset_specs_is_compact, *tc_dataset_new_1d, *tc_dataset_new_2d;
+	  *tc_dataset_specs_is_compact, *tc_dataset_new_1d, *tc_dataset_new_2d, *tc_dataset_time_series,
+	  *tc_dataset_selections, *tc_dataset_compact_selections, *tc_dataset_hl_selections,
+	  *tc_dataset_transfer_mode, *tc_dataset_aggregated, *tc_dataset_shared;
     
     s = suite_create("Datasets");
 
@@ -373,5 +704,46 @@ Suite * make_datasets_suite(void)
     tcase_add_test(tc_dataset_new_2d, test_dataset_new_string_array2);
     suite_add_tcase(s, tc_dataset_new_2d);
 
+    tc_dataset_time_series = tcase_create("Dataset time series");
+    tcase_add_checked_fixture(tc_dataset_time_series, array1_setup, array1_teardown);
+    tcase_add_test(tc_dataset_time_series, test_dataset_time_series_double_array1);
+    suite_add_tcase(s, tc_dataset_time_series);
+
+    tc_dataset_selections = tcase_create("Dataset selections");
+    tcase_add_checked_fixture(tc_dataset_selections, array1_setup, array1_teardown);
+    tcase_add_test(tc_dataset_selections, test_dataset_mem_double_array1);
+    tcase_add_test(tc_dataset_selections, test_dataset_boxes_double_array1);
+    tcase_add_test(tc_dataset_selections, test_dataset_points_double_array1);
+    suite_add_tcase(s, tc_dataset_selections);
+
+    tc_dataset_compact_selections = tcase_create("Dataset compact selections");
+    tcase_add_checked_fixture(tc_dataset_compact_selections, rows_setup, array2_teardown);
+    tcase_add_test(tc_dataset_compact_selections, test_dataset_boxes_double_rows);
+    tcase_add_test(tc_dataset_compact_selections, test_dataset_points_double_rows);
+    suite_add_tcase(s, tc_dataset_compact_selections);
+
+    tc_dataset_hl_selections = tcase_create("Dataset high-level selections");
+    tcase_add_checked_fixture(tc_dataset_hl_selections, system_setup, system_teardown);
+    tcase_add_test(tc_dataset_hl_selections, test_hl_dataset_points_species_at_site);
+    suite_add_tcase(s, tc_dataset_hl_selections);
+
+    tc_dataset_transfer_mode = tcase_create("Dataset transfer mode");
+    tcase_add_checked_fixture(tc_dataset_transfer_mode, array1_setup, array1_teardown);
+    tcase_add_test(tc_dataset_transfer_mode, test_dataset_transfer_mode_double_array1);
+    suite_add_tcase(s, tc_dataset_transfer_mode);
+
+    tc_dataset_aggregated = tcase_create("Dataset aggregated write");
+    tcase_add_checked_fixture(tc_dataset_aggregated, array1_setup, array1_teardown);
+    tcase_add_test(tc_dataset_aggregated, test_dataset_write_aggregated_double_array1);
+    suite_add_tcase(s, tc_dataset_aggregated);
+
+    tc_dataset_shared = tcase_create("Dataset shared read");
+    tcase_add_checked_fixture(tc_dataset_shared, array1_setup, array1_teardown);
+    tcase_add_test(tc_dataset_shared, test_dataset_read_shared_double_array1);
+#ifdef HAVE_MPI
+    tcase_add_test(tc_dataset_shared, test_dataset_read_shared_node_double_array1);
+#endif
+    suite_add_tcase(s, tc_dataset_shared);
+
     return s;
 }
@@ -27,6 +27,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
+#include <stdint.h>
 #include <check.h>
 #include <unistd.h>
 #include <hdf5.h>
@@ -53,21 +55,22 @@ void grid_scalarfield_setup(void)
     hsize_t d3_1[1] = {3};
     hsize_t d3_2[2] = {3, 3};
     */
-    unsigned int d1_1[1] = {1};
-    unsigned int d3_1[1] = {3};
-    unsigned int d3_2[2] = {3, 3};
+    size_t d1_1[1] = {1};
+    size_t d3_1[1] = {3};
+    size_t d3_2[2] = {3, 3};
 
 
     /* Attributes */
-    unsigned int dt[3] = {0, 1, 0};
+    hsize_t dt[3] = {0, 1, 0};
     double lv[3][3] = {{5.0, 0.0, 0.0}, {0.0, 10.0, 0.0}, {0.0, 0.0, 15.0}};
     hsize_t nc = 2;
     hsize_t ng[3] = {2, 3, 9};
     hsize_t np = 3;
     hsize_t rc = 1;
+    bool ordered = true;
 
     /* Dataset */
-    unsigned int adims[3] = {2, 54, 1};
+    size_t adims[3] = {2, 54, 1};
     double array[2][54][1];
 
     /* Internal variables */
@@ -106,9 +109,7 @@ void grid_scalarfield_setup(void)
     ierr = utils_hdf5_write_attr(subgroup_id, "real_or_complex", H5T_NATIVE_HSIZE, d1_1, 1, H5T_NATIVE_HSIZE, &rc);
 
     /* Use default ordering */
-    /*
-    ierr = utils_hdf5_write_bool_old(subgroup_id, "use_default_ordering", true);
-    */
+    ierr = utils_hdf5_write_attr_bool(subgroup_id, "use_default_ordering", NULL, 0, &ordered);
 
     /* Values on grid */
     ierr = utils_hdf5_create_dataset(subgroup_id, "values_on_grid", H5T_NATIVE_DOUBLE, adims, 3, &array_id);
@@ -545,20 +546,20 @@ START_TEST(test_write_values_on_grid)
 }
 END_TEST
 
-START_TEST(test_read_values_on_grid_sliced)
+START_TEST(test_write_values_on_grid_single)
 {
     escdf_handle_t *file_id;
     escdf_errno_t err;
     escdf_grid_scalarfield_t *scalarfield;
     escdf_direction_type dirarr[2];
-    unsigned int uarr[2], uval;
+    unsigned int uarr[2];
     double darr[4];
+    hid_t dtset_id, type_id;
 
     double dens[48];
-    unsigned int *tbl;
-    unsigned int i, j;
+    float fdens[48];
+    unsigned int i;
     
-    /* Generate a density on disk with default ordering. */
     scalarfield = escdf_grid_scalarfield_new(NULL);
 
     escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
@@ -576,98 +577,1342 @@ START_TEST(test_read_values_on_grid_sliced)
     escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
     escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
     escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    ck_assert(escdf_grid_scalarfield_get_storage_precision(scalarfield) == ESCDF_PRECISION_DOUBLE);
+    err = escdf_grid_scalarfield_set_storage_precision(scalarfield, ESCDF_PRECISION_SINGLE);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(escdf_grid_scalarfield_get_storage_precision(scalarfield) == ESCDF_PRECISION_SINGLE);
     
-    /* Create a new file using default properties. */
-    file_id = escdf_create("tmp_grid_scalarfield_read.h5", NULL);
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
     ck_assert(file_id != NULL);
 
     err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
     ck_assert(err == ESCDF_SUCCESS);
 
+    /* Values are stored as 32 bits floats on disk. */
+    dtset_id = H5Dopen(file_id->group_id, "density/values_on_grid", H5P_DEFAULT);
+    ck_assert(dtset_id >= 0);
+    type_id = H5Dget_type(dtset_id);
+    ck_assert(H5Tget_size(type_id) == 4);
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+
     for (i = 0; i  < 48; i++) {
-      dens[i] = (i < 24) ? (double)i : -((double)i - 24);
-    }
-    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id,
-                                                              dens, NULL, NULL, NULL);
-    if (err != ESCDF_SUCCESS) {
-      escdf_error_show(err, __FILE__, __LINE__, __func__);
+        dens[i] = 0.5 * i;
     }
+    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id, dens, NULL, NULL, NULL);
     ck_assert(err == ESCDF_SUCCESS);
 
+    /* Read back in both memory precisions. */
+    err = escdf_grid_scalarfield_read_values_on_grid_float(scalarfield, file_id, fdens, NULL, NULL, NULL);
+    ck_assert(err == ESCDF_SUCCESS);
+    err = escdf_grid_scalarfield_read_values_on_grid(scalarfield, file_id, dens, NULL, NULL, NULL);
+    ck_assert(err == ESCDF_SUCCESS);
     for (i = 0; i  < 48; i++) {
-      dens[i] = 0.;
+        ck_assert(fdens[i] == 0.5f * i);
+        ck_assert(dens[i] == 0.5 * i);
     }
 
-    /* Test the ordered reading. */
-    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
-                                                            dens, NULL, 24);
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_complex_type)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2];
+    double darr[4];
+    hid_t dtset_id, type_id, space_id;
+
+    double dens[96];
+    unsigned int tbl[24];
+    unsigned int i, j;
+    
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_COMPLEX);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    err = escdf_grid_scalarfield_set_use_complex_type(scalarfield, true);
     ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(escdf_grid_scalarfield_get_use_complex_type(scalarfield));
     
-    for (i = 0; i  < 48; i++) {
-      ck_assert((i < 24) ? (dens[i] == (double)i) : (dens[i] == -((double)i - 24)));
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    /* One compound element per grid point. */
+    dtset_id = H5Dopen(file_id->group_id, "density/values_on_grid", H5P_DEFAULT);
+    ck_assert(dtset_id >= 0);
+    type_id = H5Dget_type(dtset_id);
+    ck_assert(H5Tget_class(type_id) == H5T_COMPOUND);
+    H5Tclose(type_id);
+    space_id = H5Dget_space(dtset_id);
+    ck_assert(H5Sget_simple_extent_ndims(space_id) == 2);
+    H5Sclose(space_id);
+    H5Dclose(dtset_id);
+
+    for (i = 0; i  < 96; i++) {
+        dens[i] = (i % 2) ? -(double)i : (double)i;
     }
+    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id, dens, NULL, NULL, NULL);
+    ck_assert(err == ESCDF_SUCCESS);
 
-    /* Test the disordered reading. */
-    tbl = malloc(sizeof(unsigned int) * 24);
+    /* Disordered read, going through point selections. */
     for (i = 0; i  < 24; i++) {
-      tbl[i] = (i + 12) % 24;
+        tbl[i] = (i + 12) % 24;
     }
-    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
-                                                            dens, tbl, 24);
-    free(tbl);
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id, dens, tbl, 24);
     ck_assert(err == ESCDF_SUCCESS);
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < 24; i++) {
+            ck_assert(dens[(j * 24 + i) * 2 + 0] == (double)((j * 24 + tbl[i]) * 2));
+            ck_assert(dens[(j * 24 + i) * 2 + 1] == -(double)((j * 24 + tbl[i]) * 2 + 1));
+        }
+    }
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_grid_layout)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+    hid_t dtset_id, space_id;
+    hsize_t start[3], count[3];
+    unsigned int tbl[3];
+
+    double dens[24], box[8], at[3];
+    unsigned int i, x, y, z, layout;
     
-    for (i = 0; i  < 48; i++) {
-      ck_assert((i < 24) ? (dens[i] == (double)((i + 12) % 24)) :
-                (dens[i] == -(double)((i + 12) % 24)));
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    for (layout = 0; layout < 2; layout++) {
+        scalarfield = escdf_grid_scalarfield_new((layout) ? "grid" : "flat");
+
+        escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+        dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+        dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+        dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+        escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+        for (i = 0; i < 9; i++) {
+            darr[i] = (i % 4) ? 0. : 1.;
+        }
+        escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+        uarr[0] = 4;
+        uarr[1] = 3;
+        uarr[2] = 2;
+        escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+        escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+        escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+        escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+        err = escdf_grid_scalarfield_set_use_grid_layout(scalarfield, layout);
+        ck_assert(err == ESCDF_SUCCESS);
+        ck_assert(escdf_grid_scalarfield_get_use_grid_layout(scalarfield) == layout);
+        uarr[0] = 2;
+        uarr[1] = 2;
+        uarr[2] = 2;
+        err = escdf_grid_scalarfield_set_grid_chunk_dims(scalarfield, uarr, 3);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        /* The grid layout has one dimension per direction. */
+        dtset_id = H5Dopen(file_id->group_id, (layout) ? "grid/values_on_grid" : "flat/values_on_grid", H5P_DEFAULT);
+        ck_assert(dtset_id >= 0);
+        space_id = H5Dget_space(dtset_id);
+        ck_assert(H5Sget_simple_extent_ndims(space_id) == ((layout) ? 5 : 3));
+        H5Sclose(space_id);
+        H5Dclose(dtset_id);
+
+        for (i = 0; i  < 24; i++) {
+            dens[i] = 0.5 * i;
+        }
+        err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id, dens, NULL, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        /* Read a 2x2x2 box with both layouts. */
+        start[0] = 1;
+        start[1] = 1;
+        start[2] = 0;
+        count[0] = 2;
+        count[1] = 2;
+        count[2] = 2;
+        err = escdf_grid_scalarfield_read_values_on_grid_box(scalarfield, file_id, box, start, count);
+        ck_assert(err == ESCDF_SUCCESS);
+        i = 0;
+        for (z = 0; z < 2; z++) {
+            for (y = 1; y < 3; y++) {
+                for (x = 1; x < 3; x++) {
+                    ck_assert(box[i++] == 0.5 * (x + 4 * (y + 3 * z)));
+                }
+            }
+        }
+        count[0] = 4;
+        err = escdf_grid_scalarfield_read_values_on_grid_box(scalarfield, file_id, box, start, count);
+        ck_assert(err == ESCDF_ERANGE);
+
+        /* Read disordered points. */
+        tbl[0] = 17;
+        tbl[1] = 0;
+        tbl[2] = 5;
+        err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id, at, tbl, 3);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i < 3; i++) {
+            ck_assert(at[i] == 0.5 * tbl[i]);
+        }
+
+        /* Read the full slice back. */
+        for (i = 0; i  < 24; i++) {
+            dens[i] = 0.;
+        }
+        err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id, dens, NULL, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i  < 24; i++) {
+            ck_assert(dens[i] == 0.5 * i);
+        }
+
+        escdf_grid_scalarfield_free(scalarfield);
     }
 
     escdf_close(file_id);
+}
+END_TEST
 
-    file_id = escdf_create("tmp_grid_scalarfield_read.h5", NULL);
+START_TEST(test_read_region)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+    hsize_t start[3], count[3];
+    double lower[3], upper[3];
+
+    double dens[24], region[12];
+    unsigned int i, x, y, z;
+    
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    /* A grid spacing of 1 in all directions. */
+    for (i = 0; i < 9; i++) {
+        darr[i] = 0.;
+    }
+    darr[0] = 4.;
+    darr[4] = 3.;
+    darr[8] = 2.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+
+    lower[0] = 0.5;
+    lower[1] = 1.2;
+    lower[2] = 0.;
+    upper[0] = 1.5;
+    upper[1] = 1.8;
+    upper[2] = 0.5;
+    err = escdf_grid_scalarfield_get_region(scalarfield, lower, upper, start, count);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(start[0] == 0 && count[0] == 3);
+    ck_assert(start[1] == 1 && count[1] == 2);
+    ck_assert(start[2] == 0 && count[2] == 2);
+
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
     ck_assert(file_id != NULL);
 
-    /* Recreate the file disordered. */
-    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, false);
     err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
     ck_assert(err == ESCDF_SUCCESS);
-
-    tbl = malloc(sizeof(unsigned int) * 24);
     for (i = 0; i  < 24; i++) {
-      tbl[i] = (i + 12) % 24;
+        dens[i] = 0.5 * i;
     }
-    for (i = 0; i  < 48; i++) {
-      dens[i] = (i < 24) ? (double)tbl[i % 24] : -(double)tbl[i % 24];
+    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id, dens, NULL, NULL, NULL);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    err = escdf_grid_scalarfield_read_region(scalarfield, file_id, region, lower, upper);
+    ck_assert(err == ESCDF_SUCCESS);
+    i = 0;
+    for (z = 0; z < 2; z++) {
+        for (y = 1; y < 3; y++) {
+            for (x = 0; x < 3; x++) {
+                ck_assert(region[i++] == 0.5 * (x + 4 * (y + 3 * z)));
+            }
+        }
     }
-    err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id,
-                                                             dens, tbl, 24);
-    free(tbl);
-    for (i = 0; i  < 48; i++) {
-      dens[i] = 0.;
+
+    /* A box outside of the cell. */
+    lower[0] = 10.;
+    upper[0] = 12.;
+    err = escdf_grid_scalarfield_read_region(scalarfield, file_id, region, lower, upper);
+    ck_assert(err == ESCDF_ERANGE);
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_read_values_on_grid_halo)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+    hsize_t start[3], count[3];
+
+    double dens[24], halo[36], expected;
+    int i, x, y, z, gx, gy, gz, layout;
+    
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    for (layout = 0; layout < 2; layout++) {
+        scalarfield = escdf_grid_scalarfield_new((layout) ? "grid" : "flat");
+
+        escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+        dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+        dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+        dirarr[2] = ESCDF_DIRECTION_FREE;
+        escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+        for (i = 0; i < 9; i++) {
+            darr[i] = (i % 4) ? 0. : 1.;
+        }
+        escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+        uarr[0] = 4;
+        uarr[1] = 3;
+        uarr[2] = 2;
+        escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+        escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+        escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+        escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+        escdf_grid_scalarfield_set_use_grid_layout(scalarfield, layout);
+
+        err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i  < 24; i++) {
+            dens[i] = i + 1.;
+        }
+        err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id, dens, NULL, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        /* A 2x1x1 box with one ghost layer, wrapping along x and y. */
+        start[0] = 0;
+        start[1] = 2;
+        start[2] = 0;
+        count[0] = 2;
+        count[1] = 1;
+        count[2] = 1;
+        err = escdf_grid_scalarfield_read_values_on_grid_halo(scalarfield, file_id, halo, start, count, 1);
+        ck_assert(err == ESCDF_SUCCESS);
+        i = 0;
+        for (z = 0; z < 3; z++) {
+            for (y = 0; y < 3; y++) {
+                for (x = 0; x < 4; x++) {
+                    gx = (x - 1 + 4) % 4;
+                    gy = (y + 1) % 3;
+                    gz = z - 1;
+                    expected = (gz < 0 || gz > 1) ? 0. : gx + 4 * (gy + 3 * gz) + 1.;
+                    ck_assert(halo[i++] == expected);
+                }
+            }
+        }
+
+        escdf_grid_scalarfield_free(scalarfield);
     }
 
-    /* Test the ordered reading. */
-    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
-                                                            dens, NULL, 24);
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_interpolate)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+
+    double dens[60], points[9], values[3];
+    int i, x, y, z;
+    
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_FREE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    /* One grid step per unit length. */
+    for (i = 0; i < 9; i++) {
+        darr[i] = 0.;
+    }
+    darr[0] = 6.;
+    darr[4] = 5.;
+    darr[8] = 2.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 6;
+    uarr[1] = 5;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    escdf_grid_scalarfield_set_use_grid_layout(scalarfield, true);
+    uarr[0] = 2;
+    uarr[1] = 2;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_grid_chunk_dims(scalarfield, uarr, 3);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+    /* A linear field, interpolated exactly away from the wrapping. */
+    i = 0;
+    for (z = 0; z < 2; z++) {
+        for (y = 0; y < 5; y++) {
+            for (x = 0; x < 6; x++) {
+                dens[i++] = x + 10. * y + 100. * z;
+            }
+        }
+    }
+    err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id, dens, NULL, 60);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    points[0] = 2.5;
+    points[1] = 1.5;
+    points[2] = 0.5;
+    points[3] = 2.;
+    points[4] = 1.;
+    points[5] = 1.;
+    points[6] = 1.25;
+    points[7] = 3.75;
+    points[8] = 0.;
+    err = escdf_grid_scalarfield_interpolate(scalarfield, file_id, ESCDF_INTERPOLATION_LINEAR,
+                                             3, points, values);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(fabs(values[0] - 67.5) < 1e-12);
+    ck_assert(fabs(values[1] - 112.) < 1e-12);
+    ck_assert(fabs(values[2] - 38.75) < 1e-12);
+
+    points[2] = 0.;
+    err = escdf_grid_scalarfield_interpolate(scalarfield, file_id, ESCDF_INTERPOLATION_CUBIC,
+                                             1, points, values);
     ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(fabs(values[0] - 17.5) < 1e-12);
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_write_statistics)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+
+    double dens[24], vmin, vmax, vsum, vint, cmin[4], cmax[4];
+    int i;
     
-    for (i = 0; i  < 48; i++) {
-      ck_assert((i < 24) ? (dens[i] == (double)i) : (dens[i] == -((double)i - 24)));
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    for (i = 0; i < 9; i++) {
+        darr[i] = (i % 4) ? 0. : 2.;
     }
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    uarr[0] = 2;
+    uarr[1] = 2;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_grid_chunk_dims(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_use_chunk_statistics(scalarfield, true);
+    ck_assert(escdf_grid_scalarfield_get_use_chunk_statistics(scalarfield));
 
-    /* Test the disordered reading. */
-    tbl = malloc(sizeof(unsigned int) * 24);
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
     for (i = 0; i  < 24; i++) {
-      tbl[i] = (i < 12) ? i * 2 : (i % 12) * 2 + 1;
+        dens[i] = i + 1.;
     }
-    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
-                                                            dens, tbl, 24);
+    err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id, dens, NULL, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    err = escdf_grid_scalarfield_read_statistics(scalarfield, file_id, &vmin, &vmax, &vsum, &vint);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(vmin == 1.);
+    ck_assert(vmax == 24.);
+    ck_assert(vsum == 300.);
+    /* The cell volume is 8 for 24 grid points. */
+    ck_assert(fabs(vint - 100.) < 1e-12);
+
+    /* Chunks of 2x2x2 points, 2x1x2 on the y border. */
+    err = escdf_grid_scalarfield_read_chunk_statistics(scalarfield, file_id, cmin, cmax);
     ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(cmin[0] == 1. && cmax[0] == 18.);
+    ck_assert(cmin[1] == 3. && cmax[1] == 20.);
+    ck_assert(cmin[2] == 9. && cmax[2] == 22.);
+    ck_assert(cmin[3] == 11. && cmax[3] == 24.);
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_append_values_on_grid)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+
+    double dens[24], rdens[24];
+    size_t frame, nframes;
+    int i, j;
     
-    for (i = 0; i  < 48; i++) {
-      ck_assert((i < 24) ? (dens[i] == (double)tbl[i]) : (dens[i] == -(double)tbl[i - 24]));
-    }
-    free(tbl);
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    for (i = 0; i < 9; i++) {
+        darr[i] = (i % 4) ? 0. : 2.;
+    }
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    escdf_grid_scalarfield_set_use_time_series(scalarfield, true);
+    ck_assert(escdf_grid_scalarfield_get_use_time_series(scalarfield));
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+    err = escdf_grid_scalarfield_get_number_of_frames(scalarfield, file_id, &nframes);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(nframes == 0);
+
+    for (j = 0; j < 3; j++) {
+        for (i = 0; i  < 24; i++) {
+            dens[i] = 100. * j + i;
+        }
+        err = escdf_grid_scalarfield_append_values_on_grid(scalarfield, file_id, dens, NULL, &frame);
+        ck_assert(err == ESCDF_SUCCESS);
+        ck_assert(frame == (size_t)j);
+    }
+    err = escdf_grid_scalarfield_get_number_of_frames(scalarfield, file_id, &nframes);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(nframes == 3);
+
+    err = escdf_grid_scalarfield_read_values_on_grid_frame(scalarfield, file_id, 1, rdens);
+    ck_assert(err == ESCDF_SUCCESS);
+    for (i = 0; i  < 24; i++) {
+        ck_assert(rdens[i] == 100. + i);
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_frame(scalarfield, file_id, 3, rdens);
+    ck_assert(err == ESCDF_ERANGE);
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_append_values_on_grid_keyframes)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+
+    double dens[24], rdens[24];
+    size_t frame, nframes;
+    int i, j;
+    
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    for (i = 0; i < 9; i++) {
+        darr[i] = (i % 4) ? 0. : 2.;
+    }
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    escdf_grid_scalarfield_set_use_time_series(scalarfield, true);
+    escdf_grid_scalarfield_set_keyframe_interval(scalarfield, 3);
+    ck_assert(escdf_grid_scalarfield_get_keyframe_interval(scalarfield) == 3);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    /* Frames 0 and 3 are keyframes, the others are deltas. */
+    for (j = 0; j < 5; j++) {
+        for (i = 0; i  < 24; i++) {
+            dens[i] = 1. / (1. + i) + 1e-3 * j * i;
+        }
+        err = escdf_grid_scalarfield_append_values_on_grid(scalarfield, file_id, dens, NULL, &frame);
+        ck_assert(err == ESCDF_SUCCESS);
+        ck_assert(frame == (size_t)j);
+    }
+    err = escdf_grid_scalarfield_get_number_of_frames(scalarfield, file_id, &nframes);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(nframes == 5);
+
+    for (j = 4; j >= 0; j--) {
+        err = escdf_grid_scalarfield_read_values_on_grid_frame(scalarfield, file_id, j, rdens);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i  < 24; i++) {
+            ck_assert(rdens[i] == 1. / (1. + i) + 1e-3 * j * i);
+        }
+    }
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_serialise_binary)
+{
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield, *copy;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9], dens[24], *values;
+    uint32_t header[3], scalars[11];
+    uint64_t nvalues;
+    size_t len;
+    FILE *f;
+    int i;
+
+    scalarfield = escdf_grid_scalarfield_new("potential");
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_FREE;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    for (i = 0; i < 9; i++) {
+        darr[i] = (i % 4) ? 0. : 2. + i;
+    }
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    escdf_grid_scalarfield_set_keyframe_interval(scalarfield, 4);
+    for (i = 0; i  < 24; i++) {
+        dens[i] = 0.5 * i;
+    }
+
+    f = tmpfile();
+    ck_assert(f != NULL);
+    err = escdf_grid_scalarfield_serialise_binary(scalarfield, f, dens, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    err = escdf_grid_scalarfield_serialise_binary(scalarfield, f, NULL, 0);
+    ck_assert(err == ESCDF_SUCCESS);
+    rewind(f);
+
+    copy = escdf_grid_scalarfield_new(NULL);
+    err = escdf_grid_scalarfield_deserialise_binary(copy, f, &values, &len);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(len == 24);
+    for (i = 0; i  < 24; i++) {
+        ck_assert(values[i] == dens[i]);
+    }
+    free(values);
+    ck_assert(escdf_grid_scalarfield_get_number_of_physical_dimensions(copy) == 3);
+    ck_assert(escdf_grid_scalarfield_ptr_dimension_types(copy)[1] == ESCDF_DIRECTION_FREE);
+    for (i = 0; i < 9; i++) {
+        ck_assert(escdf_grid_scalarfield_ptr_lattice_vectors(copy)[i] == darr[i]);
+    }
+    ck_assert(escdf_grid_scalarfield_ptr_number_of_grid_points(copy)[0] == 4);
+    ck_assert(escdf_grid_scalarfield_ptr_number_of_grid_points(copy)[2] == 2);
+    ck_assert(escdf_grid_scalarfield_get_number_of_components(copy) == 1);
+    ck_assert(escdf_grid_scalarfield_get_real_or_complex(copy) == ESCDF_REAL);
+    ck_assert(escdf_grid_scalarfield_get_use_default_ordering(copy));
+    ck_assert(escdf_grid_scalarfield_get_keyframe_interval(copy) == 4);
+    ck_assert(!escdf_grid_scalarfield_get_use_grid_layout(copy));
+
+    err = escdf_grid_scalarfield_deserialise_binary(copy, f, &values, &len);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(values == NULL && len == 0);
+    fclose(f);
+
+    /* A version 1 stream, without compression_level: one dimension of
+       5 points, 2 components, a keyframe interval of 3 and the default
+       ordering. */
+    f = tmpfile();
+    ck_assert(f != NULL);
+    header[0] = 0x01020304u;
+    header[1] = 1;
+    header[2] = (1u << 0) | (1u << 1) | (1u << 5) | (1u << 6) | (1u << 13);
+    fwrite("ESCDFGSF", 1, 8, f);
+    fwrite(header, sizeof(uint32_t), 3, f);
+    scalars[0] = 0;
+    fwrite(scalars, sizeof(uint32_t), 1, f);
+    for (i = 0; i < 11; i++) {
+        scalars[i] = 0;
+    }
+    scalars[0] = 1;
+    scalars[1] = 2;
+    scalars[5] = 3;
+    scalars[6] = 1;
+    fwrite(scalars, sizeof(uint32_t), 11, f);
+    scalars[0] = 5;
+    fwrite(scalars, sizeof(uint32_t), 1, f);
+    nvalues = 0;
+    fwrite(&nvalues, sizeof(uint64_t), 1, f);
+    rewind(f);
+    err = escdf_grid_scalarfield_deserialise_binary(copy, f, &values, &len);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(values == NULL && len == 0);
+    ck_assert(escdf_grid_scalarfield_get_number_of_physical_dimensions(copy) == 1);
+    ck_assert(escdf_grid_scalarfield_ptr_number_of_grid_points(copy)[0] == 5);
+    ck_assert(escdf_grid_scalarfield_get_number_of_components(copy) == 2);
+    ck_assert(escdf_grid_scalarfield_get_keyframe_interval(copy) == 3);
+    ck_assert(escdf_grid_scalarfield_get_compression_level(copy) == 0);
+    ck_assert(escdf_grid_scalarfield_get_use_default_ordering(copy));
+    ck_assert(!escdf_grid_scalarfield_get_use_grid_layout(copy));
+
+    /* Corrupted sizes are rejected before any allocation. */
+    rewind(f);
+    fwrite("ESCDFGSF", 1, 8, f);
+    fwrite(header, sizeof(uint32_t), 3, f);
+    scalars[0] = 0xFFFFFFFFu;
+    fwrite(scalars, sizeof(uint32_t), 1, f);
+    rewind(f);
+    err = escdf_grid_scalarfield_deserialise_binary(copy, f, &values, &len);
+    ck_assert(err == ESCDF_ERANGE);
+    rewind(f);
+    fwrite("ESCDFGSF", 1, 8, f);
+    fwrite(header, sizeof(uint32_t), 3, f);
+    scalars[0] = 0;
+    fwrite(scalars, sizeof(uint32_t), 1, f);
+    scalars[0] = 1;
+    scalars[5] = 3;
+    scalars[6] = 1;
+    fwrite(scalars, sizeof(uint32_t), 11, f);
+    scalars[0] = 5;
+    fwrite(scalars, sizeof(uint32_t), 1, f);
+    nvalues = UINT64_MAX;
+    fwrite(&nvalues, sizeof(uint64_t), 1, f);
+    rewind(f);
+    err = escdf_grid_scalarfield_deserialise_binary(copy, f, &values, &len);
+    ck_assert(err == ESCDF_ERANGE);
+    ck_assert(values == NULL);
+    fclose(f);
+
+    escdf_grid_scalarfield_free(copy);
+    escdf_grid_scalarfield_free(scalarfield);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_levels)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[3];
+    unsigned int uarr[3];
+    double darr[9];
+
+    double dens[24], level1[4], level2[1], expected;
+    unsigned int i, x, y, z, dx, dy, dz, n;
+    
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 3);
+    dirarr[0] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[1] = ESCDF_DIRECTION_PERIODIC;
+    dirarr[2] = ESCDF_DIRECTION_PERIODIC;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 3);
+    for (i = 0; i < 9; i++) {
+        darr[i] = (i % 4) ? 0. : 1.;
+    }
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 9);
+    uarr[0] = 4;
+    uarr[1] = 3;
+    uarr[2] = 2;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 3);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 1);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    err = escdf_grid_scalarfield_set_number_of_levels(scalarfield, 2);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(escdf_grid_scalarfield_get_number_of_levels(scalarfield) == 2);
+    err = escdf_grid_scalarfield_get_level_number_of_grid_points(scalarfield, 1, uarr, 3);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(uarr[0] == 2 && uarr[1] == 2 && uarr[2] == 1);
+
+    file_id = escdf_create("tmp_grid_scalarfield_write.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+    for (i = 0; i  < 24; i++) {
+        dens[i] = 0.5 * i;
+    }
+    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id, dens, NULL, NULL, NULL);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    /* Level 1 averages blocks of 2x2x2 points, or 2x1x2 on the border. */
+    err = escdf_grid_scalarfield_read_values_on_grid_level(scalarfield, file_id, 1, level1);
+    ck_assert(err == ESCDF_SUCCESS);
+    i = 0;
+    for (y = 0; y < 2; y++) {
+        for (x = 0; x < 2; x++) {
+            expected = 0.;
+            n = 0;
+            for (dz = 0; dz < 2; dz++) {
+                for (dy = 2 * y; dy < 2 * y + 2 && dy < 3; dy++) {
+                    for (dx = 2 * x; dx < 2 * x + 2; dx++) {
+                        expected += dens[dx + 4 * (dy + 3 * dz)];
+                        n += 1;
+                    }
+                }
+            }
+            ck_assert(fabs(level1[i++] - expected / n) < 1e-12);
+        }
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_level(scalarfield, file_id, 2, level2);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(fabs(level2[0] - 0.25 * (level1[0] + level1[1] + level1[2] + level1[3])) < 1e-12);
+    err = escdf_grid_scalarfield_read_values_on_grid_level(scalarfield, file_id, 3, level2);
+    ck_assert(err == ESCDF_ERANGE);
+
+    /* Levels can also be computed from the values on disk. */
+    err = escdf_grid_scalarfield_write_levels(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+    err = escdf_grid_scalarfield_read_values_on_grid_level(scalarfield, file_id, 2, &expected);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(expected == level2[0]);
+
+    escdf_grid_scalarfield_free(scalarfield);
+
+    escdf_close(file_id);
+}
+END_TEST
+
+START_TEST(test_read_values_on_grid_sliced)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2], uval;
+    double darr[4];
+
+    double dens[48];
+    unsigned int *tbl;
+    unsigned int i, j;
+    
+    /* Generate a density on disk with default ordering. */
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+    
+    /* Create a new file using default properties. */
+    file_id = escdf_create("tmp_grid_scalarfield_read.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    for (i = 0; i  < 48; i++) {
+      dens[i] = (i < 24) ? (double)i : -((double)i - 24);
+    }
+    err = escdf_grid_scalarfield_write_values_on_grid_ordered(scalarfield, file_id,
+                                                              dens, NULL, NULL, NULL);
+    if (err != ESCDF_SUCCESS) {
+      escdf_error_show(err, __FILE__, __LINE__, __func__);
+    }
+    ck_assert(err == ESCDF_SUCCESS);
+
+    for (i = 0; i  < 48; i++) {
+      dens[i] = 0.;
+    }
+
+    /* Test the ordered reading. */
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                            dens, NULL, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    
+    for (i = 0; i  < 48; i++) {
+      ck_assert((i < 24) ? (dens[i] == (double)i) : (dens[i] == -((double)i - 24)));
+    }
+
+    /* Test the disordered reading. */
+    tbl = malloc(sizeof(unsigned int) * 24);
+    for (i = 0; i  < 24; i++) {
+      tbl[i] = (i + 12) % 24;
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                            dens, tbl, 24);
+    free(tbl);
+    ck_assert(err == ESCDF_SUCCESS);
+    
+    for (i = 0; i  < 48; i++) {
+      ck_assert((i < 24) ? (dens[i] == (double)((i + 12) % 24)) :
+                (dens[i] == -(double)((i + 12) % 24)));
+    }
+
+    escdf_close(file_id);
+
+    file_id = escdf_create("tmp_grid_scalarfield_read.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    /* Recreate the file disordered. */
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, false);
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    tbl = malloc(sizeof(unsigned int) * 24);
+    for (i = 0; i  < 24; i++) {
+      tbl[i] = (i + 12) % 24;
+    }
+    for (i = 0; i  < 48; i++) {
+      dens[i] = (i < 24) ? (double)tbl[i % 24] : -(double)tbl[i % 24];
+    }
+    err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id,
+                                                             dens, tbl, 24);
+    free(tbl);
+    for (i = 0; i  < 48; i++) {
+      dens[i] = 0.;
+    }
+
+    /* Test the ordered reading. */
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                            dens, NULL, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    
+    for (i = 0; i  < 48; i++) {
+      ck_assert((i < 24) ? (dens[i] == (double)i) : (dens[i] == -((double)i - 24)));
+    }
+
+    /* Test the disordered reading. */
+    tbl = malloc(sizeof(unsigned int) * 24);
+    for (i = 0; i  < 24; i++) {
+      tbl[i] = (i < 12) ? i * 2 : (i % 12) * 2 + 1;
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                            dens, tbl, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    
+    for (i = 0; i  < 48; i++) {
+      ck_assert((i < 24) ? (dens[i] == (double)tbl[i]) : (dens[i] == -(double)tbl[i - 24]));
+    }
+    free(tbl);
+
+    escdf_close(file_id);
+
+    escdf_grid_scalarfield_free(scalarfield);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_sliced_at)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2];
+    double darr[4];
+
+    double dens[48];
+    hsize_t offset;
+    unsigned int i, j;
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+
+    file_id = escdf_create("tmp_grid_scalarfield_sliced_at.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    /* The slices must cover the grid. */
+    err = escdf_grid_scalarfield_get_slice_offset(scalarfield, file_id, 23, &offset);
+    ck_assert(err == ESCDF_ESIZE);
+    err = escdf_grid_scalarfield_get_slice_offset(scalarfield, file_id, 24, &offset);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(offset == 0);
+
+    /* Reuse the offset for repeated writes. */
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < 48; i++) {
+            dens[i] = (double)(i + j);
+        }
+        err = escdf_grid_scalarfield_write_values_on_grid_sliced_at(scalarfield, file_id,
+                                                                    dens, NULL, offset, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+    }
+
+    for (i = 0; i < 48; i++) {
+        dens[i] = 0.;
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced_at(scalarfield, file_id,
+                                                               dens, NULL, offset, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    for (i = 0; i < 48; i++) {
+        ck_assert(dens[i] == (double)(i + 1));
+    }
+
+    escdf_close(file_id);
+
+    escdf_grid_scalarfield_free(scalarfield);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_redistributed)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2];
+    double darr[4];
+
+    double dens[48];
+    unsigned int tbl[24];
+    unsigned int i, j;
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+
+    /* Try both a contiguous and a compressed, chunked storage. */
+    for (j = 0; j < 2; j++) {
+        escdf_grid_scalarfield_set_compression_level(scalarfield, 6 * j);
+
+        file_id = escdf_create("tmp_grid_scalarfield_redistributed.h5", NULL);
+        ck_assert(file_id != NULL);
+
+        err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        /* Values given in a disordered way. */
+        for (i = 0; i < 24; i++) {
+            tbl[i] = (i * 5) % 24;
+            dens[i] = (double)tbl[i];
+            dens[24 + i] = -(double)tbl[i];
+        }
+        tbl[0] = 24;
+        err = escdf_grid_scalarfield_write_values_on_grid_redistributed(scalarfield, file_id,
+                                                                        dens, tbl, 24);
+        ck_assert(err == ESCDF_ERANGE);
+        /* A duplicated index leaves another point missing. */
+        tbl[0] = tbl[1];
+        err = escdf_grid_scalarfield_write_values_on_grid_redistributed(scalarfield, file_id,
+                                                                        dens, tbl, 24);
+        ck_assert(err == ESCDF_ESIZE);
+        tbl[0] = 0;
+        err = escdf_grid_scalarfield_write_values_on_grid_redistributed(scalarfield, file_id,
+                                                                        dens, tbl, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        /* They are stored in the default ordering. */
+        for (i = 0; i < 48; i++) {
+            dens[i] = 0.;
+        }
+        err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                                dens, NULL, 24);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i < 24; i++) {
+            ck_assert(dens[i] == (double)i);
+            ck_assert(dens[24 + i] == -(double)i);
+        }
+
+        escdf_close(file_id);
+    }
+
+    escdf_grid_scalarfield_free(scalarfield);
+}
+END_TEST
+
+START_TEST(test_read_values_on_grid_redistributed)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2];
+    double darr[4];
+
+    double dens[48], vals[20];
+    unsigned int tbl[24], req[10];
+    unsigned int i, j;
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+
+    /* A scattered set of points, with repetitions. */
+    for (i = 0; i < 10; i++) {
+        req[i] = (i * 7 + 3) % 24;
+    }
+    req[9] = req[2];
+
+    /* Try the default, a compressed and a disordered storage. */
+    for (j = 0; j < 3; j++) {
+        escdf_grid_scalarfield_set_use_default_ordering(scalarfield, (j < 2));
+        escdf_grid_scalarfield_set_compression_level(scalarfield, (j == 1) ? 6 : 0);
+
+        file_id = escdf_create("tmp_grid_scalarfield_read_redistributed.h5", NULL);
+        ck_assert(file_id != NULL);
+
+        err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+        ck_assert(err == ESCDF_SUCCESS);
+
+        for (i = 0; i < 24; i++) {
+            tbl[i] = (i + 12) % 24;
+            dens[i] = (double)tbl[i];
+            dens[24 + i] = -(double)tbl[i];
+        }
+        if (j < 2) {
+            err = escdf_grid_scalarfield_write_values_on_grid_redistributed(scalarfield, file_id,
+                                                                            dens, tbl, 24);
+        } else {
+            err = escdf_grid_scalarfield_write_values_on_grid_sliced(scalarfield, file_id,
+                                                                     dens, tbl, 24);
+        }
+        ck_assert(err == ESCDF_SUCCESS);
+
+        for (i = 0; i < 20; i++) {
+            vals[i] = 0.;
+        }
+        err = escdf_grid_scalarfield_read_values_on_grid_redistributed(scalarfield, file_id,
+                                                                       vals, req, 10);
+        ck_assert(err == ESCDF_SUCCESS);
+        for (i = 0; i < 10; i++) {
+            ck_assert(vals[i] == (double)req[i]);
+            ck_assert(vals[10 + i] == -(double)req[i]);
+        }
+
+        escdf_close(file_id);
+    }
+
+    escdf_grid_scalarfield_free(scalarfield);
+}
+END_TEST
+
+START_TEST(test_write_values_on_grid_compressed)
+{
+    escdf_handle_t *file_id;
+    escdf_errno_t err;
+    escdf_grid_scalarfield_t *scalarfield;
+    escdf_direction_type dirarr[2];
+    unsigned int uarr[2];
+    double darr[4];
+
+    double dens[48];
+    unsigned int tbl[24];
+    unsigned int i;
+    hid_t dtset_id, dcpl_id;
+    hsize_t chunk[3];
+
+    scalarfield = escdf_grid_scalarfield_new(NULL);
+
+    escdf_grid_scalarfield_set_number_of_physical_dimensions(scalarfield, 2);
+    dirarr[0] = ESCDF_DIRECTION_FREE;
+    dirarr[1] = ESCDF_DIRECTION_SEMI_INFINITE;
+    escdf_grid_scalarfield_set_dimension_types(scalarfield, dirarr, 2);
+    darr[0] = 1.;
+    darr[1] = 2.;
+    darr[2] = 3.;
+    darr[3] = 4.;
+    escdf_grid_scalarfield_set_lattice_vectors(scalarfield, darr, 4);
+    uarr[0] = 6;
+    uarr[1] = 4;
+    escdf_grid_scalarfield_set_number_of_grid_points(scalarfield, uarr, 2);
+    escdf_grid_scalarfield_set_number_of_components(scalarfield, 2);
+    escdf_grid_scalarfield_set_real_or_complex(scalarfield, ESCDF_REAL);
+    escdf_grid_scalarfield_set_use_default_ordering(scalarfield, true);
+
+    ck_assert(escdf_grid_scalarfield_get_compression_level(scalarfield) == 0);
+    err = escdf_grid_scalarfield_set_compression_level(scalarfield, 10);
+    ck_assert(err == ESCDF_ERANGE);
+    err = escdf_grid_scalarfield_set_compression_level(scalarfield, 4);
+    ck_assert(err == ESCDF_SUCCESS);
+    ck_assert(escdf_grid_scalarfield_get_compression_level(scalarfield) == 4);
+
+    file_id = escdf_create("tmp_grid_scalarfield_compressed.h5", NULL);
+    ck_assert(file_id != NULL);
+
+    err = escdf_grid_scalarfield_write_metadata(scalarfield, file_id);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    /* One chunk per component for a single process. */
+    dtset_id = H5Dopen(file_id->group_id, "density/values_on_grid", H5P_DEFAULT);
+    ck_assert(dtset_id >= 0);
+    dcpl_id = H5Dget_create_plist(dtset_id);
+    ck_assert(H5Pget_nfilters(dcpl_id) == 2);
+    ck_assert(H5Pget_chunk(dcpl_id, 3, chunk) >= 2);
+    ck_assert(chunk[0] == 1 && chunk[1] == 24);
+    H5Pclose(dcpl_id);
+    H5Dclose(dtset_id);
+
+    for (i = 0; i < 24; i++) {
+        tbl[i] = (i + 12) % 24;
+        dens[i] = (double)tbl[i];
+        dens[24 + i] = -(double)tbl[i];
+    }
+    err = escdf_grid_scalarfield_write_values_on_grid_redistributed(scalarfield, file_id,
+                                                                    dens, tbl, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+
+    for (i = 0; i < 48; i++) {
+        dens[i] = 0.;
+    }
+    err = escdf_grid_scalarfield_read_values_on_grid_sliced(scalarfield, file_id,
+                                                            dens, NULL, 24);
+    ck_assert(err == ESCDF_SUCCESS);
+    for (i = 0; i < 24; i++) {
+        ck_assert(dens[i] == (double)i);
+        ck_assert(dens[24 + i] == -(double)i);
+    }
 
     escdf_close(file_id);
 
@@ -695,7 +1940,22 @@ Suite * make_grid_scalarfield_suite(void)
     tcase_add_test(tc_info, test_write_metadata);
     tcase_add_test(tc_info, test_read_values_on_grid);
     tcase_add_test(tc_info, test_write_values_on_grid);
+    tcase_add_test(tc_info, test_write_values_on_grid_single);
+    tcase_add_test(tc_info, test_write_values_on_grid_complex_type);
+    tcase_add_test(tc_info, test_write_values_on_grid_grid_layout);
+    tcase_add_test(tc_info, test_read_region);
+    tcase_add_test(tc_info, test_read_values_on_grid_halo);
+    tcase_add_test(tc_info, test_write_values_on_grid_levels);
+    tcase_add_test(tc_info, test_interpolate);
+    tcase_add_test(tc_info, test_write_statistics);
+    tcase_add_test(tc_info, test_append_values_on_grid);
+    tcase_add_test(tc_info, test_append_values_on_grid_keyframes);
+    tcase_add_test(tc_info, test_serialise_binary);
     tcase_add_test(tc_info, test_read_values_on_grid_sliced);
+    tcase_add_test(tc_info, test_write_values_on_grid_sliced_at);
+    tcase_add_test(tc_info, test_write_values_on_grid_redistributed);
+    tcase_add_test(tc_info, test_read_values_on_grid_redistributed);
+    tcase_add_test(tc_info, test_write_values_on_grid_compressed);
     tcase_add_checked_fixture(tc_info, grid_scalarfield_setup, grid_scalarfield_teardown);
     suite_add_tcase(s, tc_info);
 
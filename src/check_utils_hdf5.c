@@ -476,6 +476,68 @@ START_TEST(test_utils_hdf5_read_dataset_sliced)
 }
 END_TEST
 
+START_TEST(test_utils_hdf5_read_dataset_mem)
+{
+    hid_t dtset_id = 0;
+    double values[4][4];
+    hsize_t start[2] = {1, 0};
+    hsize_t count[2] = {2, 2};
+    hsize_t mem_dims[2] = {4, 4};
+    hsize_t mem_start[2] = {1, 1};
+    hsize_t mem_count[2] = {2, 2};
+    int i, j;
+
+    for (i = 0; i < 4; i++)
+        for (j = 0; j < 4; j++)
+            values[i][j] = -1.0;
+
+    ck_assert(utils_hdf5_check_dataset(group_id, DATASET, dims, 2, &dtset_id) == ESCDF_SUCCESS);
+    ck_assert(utils_hdf5_read_dataset_mem(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE, start, count, NULL,
+                                          mem_dims, 2, mem_start, mem_count, NULL) == ESCDF_SUCCESS);
+    ck_assert(values[1][1] == 3.0);
+    ck_assert(values[1][2] == 4.0);
+    ck_assert(values[2][1] == 5.0);
+    ck_assert(values[2][2] == 6.0);
+    /* The ghost layer is untouched. */
+    ck_assert(values[0][0] == -1.0);
+    ck_assert(values[1][0] == -1.0);
+    ck_assert(values[3][3] == -1.0);
+
+    /* Selections of different sizes are rejected. */
+    mem_count[0] = 3;
+    ck_assert(utils_hdf5_read_dataset_mem(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE, start, count, NULL,
+                                          mem_dims, 2, mem_start, mem_count, NULL) != ESCDF_SUCCESS);
+    H5Dclose(dtset_id);
+}
+END_TEST
+
+START_TEST(test_utils_hdf5_read_dataset_boxes)
+{
+    hid_t dtset_id = 0;
+    double values[4];
+    /* Two disjoint boxes given in reverse order. */
+    hsize_t start[4] = {2, 0,
+                        0, 1};
+    hsize_t count[4] = {1, 2,
+                        2, 1};
+
+    ck_assert(utils_hdf5_check_dataset(group_id, DATASET, dims, 2, &dtset_id) == ESCDF_SUCCESS);
+    ck_assert(utils_hdf5_read_dataset_boxes(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE,
+                                            2, start, count, NULL) == ESCDF_SUCCESS);
+    /* Row-major order of the union. */
+    ck_assert(values[0] == 2.0);
+    ck_assert(values[1] == 4.0);
+    ck_assert(values[2] == 5.0);
+    ck_assert(values[3] == 6.0);
+
+    /* Overlapping boxes are rejected. */
+    start[0] = 1;
+    ck_assert(utils_hdf5_read_dataset_boxes(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE,
+                                            2, start, count, NULL) != ESCDF_SUCCESS);
+    H5Dclose(dtset_id);
+}
+END_TEST
+
 /* read_dataset_at */
 START_TEST(test_utils_hdf5_read_dataset_at)
 {
@@ -505,6 +567,28 @@ START_TEST(test_utils_hdf5_read_dataset_at)
 }
 END_TEST
 
+START_TEST(test_utils_hdf5_read_dataset_at_rank1)
+{
+    hid_t dtset_id, space_id;
+    hsize_t len = 6;
+    double data[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    size_t coordinates[3] = {5, 0, 3};
+    double values[3];
+
+    space_id = H5Screate_simple(1, &len, NULL);
+    dtset_id = H5Dcreate(group_id, "flat", H5T_NATIVE_DOUBLE, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(dtset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    H5Sclose(space_id);
+
+    ck_assert(utils_hdf5_read_dataset_at(dtset_id, H5P_DEFAULT, values, H5T_NATIVE_DOUBLE, 3, coordinates) == ESCDF_SUCCESS);
+    ck_assert(values[0] == 6.0);
+    ck_assert(values[1] == 1.0);
+    ck_assert(values[2] == 4.0);
+
+    H5Dclose(dtset_id);
+}
+END_TEST
+
 START_TEST(test_utils_hdf5_read_dataset_at_empty)
 {
     hid_t dtset_id = 0;
@@ -709,6 +793,34 @@ START_TEST(test_utils_hdf5_write_dataset)
 }
 END_TEST
 
+START_TEST(test_utils_hdf5_append_frame)
+{
+    hid_t dtset_id;
+    double values[3][2];
+    size_t frame = 0, nframes = 0;
+    size_t start[3] = {1, 0, 0};
+    size_t count[3] = {1, 3, 2};
+    bool has_frames = false;
+
+    ck_assert(utils_hdf5_create_dataset_frames(group_id, "somedataset", H5T_NATIVE_DOUBLE, dims, 2, &dtset_id) == ESCDF_SUCCESS);
+    ck_assert(utils_hdf5_get_frames(dtset_id, &has_frames, &nframes) == ESCDF_SUCCESS);
+    ck_assert(has_frames && nframes == 0);
+    ck_assert(utils_hdf5_append_frame(dtset_id, H5P_DEFAULT, &int_array, H5T_NATIVE_INT, &frame) == ESCDF_SUCCESS);
+    ck_assert(frame == 0);
+    ck_assert(utils_hdf5_append_frame(dtset_id, H5P_DEFAULT, &dbl_array, H5T_NATIVE_DOUBLE, &frame) == ESCDF_SUCCESS);
+    ck_assert(frame == 1);
+    ck_assert(utils_hdf5_get_frames(dtset_id, &has_frames, &nframes) == ESCDF_SUCCESS);
+    ck_assert(has_frames && nframes == 2);
+    ck_assert(utils_hdf5_read_dataset(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE, start, count, NULL) == ESCDF_SUCCESS);
+    ck_assert(values[0][0] == dbl_array[0][0]);
+    ck_assert(values[2][1] == dbl_array[2][1]);
+    H5Dclose(dtset_id);
+
+    ck_assert(utils_hdf5_get_frames(dataset_id, &has_frames, &nframes) == ESCDF_SUCCESS);
+    ck_assert(!has_frames);
+}
+END_TEST
+
 START_TEST(test_utils_hdf5_write_dataset_slice)
 {
     hid_t dtset_id;
@@ -726,6 +838,30 @@ START_TEST(test_utils_hdf5_write_dataset_slice)
 }
 END_TEST
 
+START_TEST(test_utils_hdf5_write_dataset_mem)
+{
+    hid_t dtset_id;
+    /* Interleaved array, only the first column is written. */
+    double array[3][2] = {{1.0, -1.0},
+                          {2.0, -1.0},
+                          {3.0, -1.0}};
+    double values[3][2];
+    hsize_t start[2] = {0, 1};
+    hsize_t count[2] = {3, 1};
+    hsize_t mem_dims[2] = {3, 2};
+    hsize_t mem_start[2] = {0, 0};
+    hsize_t mem_count[2] = {3, 1};
+
+    ck_assert(utils_hdf5_create_dataset(group_id, "somedataset", H5T_NATIVE_DOUBLE, dims, 2, &dtset_id) == ESCDF_SUCCESS);
+    ck_assert(utils_hdf5_write_dataset_mem(dtset_id, H5P_DEFAULT, &array, H5T_NATIVE_DOUBLE, start, count, NULL,
+                                           mem_dims, 2, mem_start, mem_count, NULL) == ESCDF_SUCCESS);
+    ck_assert(utils_hdf5_read_dataset(dtset_id, H5P_DEFAULT, &values, H5T_NATIVE_DOUBLE, NULL, NULL, NULL) == ESCDF_SUCCESS);
+    ck_assert(values[0][1] == 1.0);
+    ck_assert(values[1][1] == 2.0);
+    ck_assert(values[2][1] == 3.0);
+}
+END_TEST
+
 
 Suite * make_utils_hdf5_suite(void)
 {
@@ -799,7 +935,10 @@ Suite * make_utils_hdf5_suite(void)
     tcase_add_checked_fixture(tc_utils_hdf5_read_dataset, utils_hdf5_setup, utils_hdf5_teardown);
     tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset);
     tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_sliced);
+    tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_mem);
+    tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_boxes);
     tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_at);
+    tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_at_rank1);
     tcase_add_test(tc_utils_hdf5_read_dataset, test_utils_hdf5_read_dataset_at_empty);
     suite_add_tcase(s, tc_utils_hdf5_read_dataset);
 
@@ -841,6 +980,8 @@ Suite * make_utils_hdf5_suite(void)
     tcase_add_checked_fixture(tc_utils_hdf5_write_dataset, utils_hdf5_setup, utils_hdf5_teardown);
     tcase_add_test(tc_utils_hdf5_write_dataset, test_utils_hdf5_write_dataset);
     tcase_add_test(tc_utils_hdf5_write_dataset, test_utils_hdf5_write_dataset_slice);
+    tcase_add_test(tc_utils_hdf5_write_dataset, test_utils_hdf5_append_frame);
+    tcase_add_test(tc_utils_hdf5_write_dataset, test_utils_hdf5_write_dataset_mem);
     suite_add_tcase(s, tc_utils_hdf5_write_dataset);
 
     return s;
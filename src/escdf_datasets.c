@@ -19,6 +19,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 
 #include "escdf_attributes.h"
@@ -39,6 +40,15 @@ struct escdf_dataset {
     bool ordered_flag_set;
     bool transfer_on_disk;
 
+    /**
+     * @brief time series flag
+     * 
+     * If set, the dataset on disk has an additional, unlimited, leading
+     * dimension indexing the frames, and dims refers to one frame.
+     */
+    bool is_time_series;
+    size_t number_of_frames;
+
     /**
      * @brief effective number of dimensions
      * 
@@ -72,11 +82,22 @@ struct escdf_dataset {
     escdf_datatransfer_t *transfer;
     
     hid_t type_id;
+    escdf_transfer_mode_t transfer_mode;
     hid_t xfer_id;
 
     hid_t dtset_id;
 };
 
+struct escdf_shared {
+    void *data;
+    size_t size;
+
+#ifdef HAVE_MPI
+    /* shared memory window of the node, or MPI_WIN_NULL for private memory */
+    MPI_Win win;
+#endif
+};
+
 
 size_t escdf_dataset_specs_sizeof(const escdf_dataset_specs_t *specs)
 {
@@ -251,6 +272,8 @@ escdf_dataset_t * escdf_dataset_new(const escdf_dataset_specs_t *specs, escdf_at
     data->is_ordered = true;
     data->transfer = NULL;
     data->transfer_on_disk = false;
+    data->is_time_series = false;
+    data->number_of_frames = 0;
 
     data->type_id = utils_hdf5_disk_type(specs->datatype);
 
@@ -260,7 +283,8 @@ escdf_dataset_t * escdf_dataset_new(const escdf_dataset_specs_t *specs, escdf_at
         assert(H5Tset_strpad(data->type_id, H5T_STR_NULLTERM)>=0);
     }
 
-    /* QUESTION: Where do we define the xfer_id? */
+    /* The HDF5 default transfer, unless escdf_dataset_set_transfer_mode() is called. */
+    data->transfer_mode = ESCDF_TRANSFER_DEFAULT;
     data->xfer_id = ESCDF_UNDEFINED_ID;
    
 #ifdef DEBUG
@@ -275,10 +299,37 @@ void escdf_dataset_free(escdf_dataset_t *data)
     if (data != NULL) {
         free(data->dims);
         free(data->dims_attr);
+        if (data->xfer_id != ESCDF_UNDEFINED_ID && data->xfer_id != H5P_DEFAULT) {
+            H5Pclose(data->xfer_id);
+        }
     }
     free(data);
 }
 
+escdf_transfer_mode_t escdf_dataset_get_transfer_mode(const escdf_dataset_t *data)
+{
+    assert(data != NULL);
+
+    return data->transfer_mode;
+}
+
+escdf_errno_t escdf_dataset_set_transfer_mode(escdf_dataset_t *data, escdf_transfer_mode_t mode)
+{
+    hid_t xfer_id;
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(mode >= ESCDF_TRANSFER_DEFAULT && mode < ESCDF_N_TRANSFER_MODES, ESCDF_ERANGE);
+
+    FULFILL_OR_RETURN((xfer_id = escdf_transfer_create(mode)) >= 0, ESCDF_ERROR);
+    if (data->xfer_id != ESCDF_UNDEFINED_ID && data->xfer_id != H5P_DEFAULT) {
+        H5Pclose(data->xfer_id);
+    }
+    data->transfer_mode = mode;
+    data->xfer_id = (xfer_id == H5P_DEFAULT) ? ESCDF_UNDEFINED_ID : xfer_id;
+
+    return ESCDF_SUCCESS;
+}
+
 
 
 
@@ -307,6 +358,36 @@ escdf_errno_t escdf_dataset_set_ordered(escdf_dataset_t *data, bool ordered)
     return ESCDF_SUCCESS;
 }
 
+bool escdf_dataset_is_time_series(const escdf_dataset_t *data)
+{
+    assert(data != NULL);
+
+    return data->is_time_series;
+}
+
+escdf_errno_t escdf_dataset_set_time_series(escdf_dataset_t *data, bool time_series)
+{
+    assert(data != NULL);
+
+    /* The layout is fixed once the dataset exists on disk. */
+    if (data->dtset_id != ESCDF_UNDEFINED_ID)
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+
+    if (time_series && data->specs->compact)
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+
+    data->is_time_series = time_series;
+
+    return ESCDF_SUCCESS;
+}
+
+size_t escdf_dataset_get_number_of_frames(const escdf_dataset_t *data)
+{
+    assert(data != NULL);
+
+    return data->number_of_frames;
+}
+
 escdf_datatransfer_t * escdf_dataset_get_datatransfer(const escdf_dataset_t * data)
 {
     assert(data != NULL);
@@ -343,8 +424,14 @@ escdf_errno_t escdf_dataset_create(escdf_dataset_t *data, hid_t loc_id)
 #ifdef DEBUG
         printf("%s (%s, %d): calling utils_hdf5_create_dataset().\n",__func__, __FILE__, __LINE__); fflush(stdout); 
 #endif
-        error = utils_hdf5_create_dataset(loc_id, data->specs->name, 
-						    data->type_id, data->dims, data->ndims_effective, &data->dtset_id);
+        if (data->is_time_series) {
+            error = utils_hdf5_create_dataset_frames(loc_id, data->specs->name,
+                                                     data->type_id, data->dims, data->ndims_effective, &data->dtset_id);
+            data->number_of_frames = 0;
+        } else {
+            error = utils_hdf5_create_dataset(loc_id, data->specs->name, 
+                                              data->type_id, data->dims, data->ndims_effective, &data->dtset_id);
+        }
 
 #ifdef DEBUG
         printf("%s (%s, %d): utils_hdf5_create_dataset() returned %d.\n",__func__, __FILE__, __LINE__, error); fflush(stdout); 
@@ -406,6 +493,9 @@ escdf_errno_t escdf_dataset_open(escdf_dataset_t *data, hid_t loc_id)
     if (!utils_hdf5_check_present_attr(data->dtset_id, "transfer") && !data->is_ordered) {
 	RETURN_WITH_ERROR(ESCDF_ERROR);
     }
+
+    /* an unlimited leading dimension indexes the frames of a time series */
+    SUCCEED_OR_RETURN(utils_hdf5_get_frames(data->dtset_id, &data->is_time_series, &data->number_of_frames));
     
     return ESCDF_SUCCESS;
 }
@@ -424,14 +514,178 @@ escdf_errno_t escdf_dataset_close(escdf_dataset_t *data)
     return ESCDF_SUCCESS;
 }
 
+escdf_shared_t * escdf_dataset_read_shared(const escdf_dataset_t *data, const escdf_handle_t *handle)
+{
+    escdf_shared_t *shared;
+    escdf_errno_t err;
+    hid_t mem_type_id;
+    unsigned int i;
+    size_t nelems;
+#ifdef HAVE_MPI
+    escdf_dataset_t tmp;
+    int node_rank;
+    MPI_Aint size;
+    int disp_unit;
+#endif
+
+    FULFILL_OR_RETURN_VAL(data != NULL, ESCDF_EOBJECT, NULL);
+    FULFILL_OR_RETURN_VAL(handle != NULL, ESCDF_EOBJECT, NULL);
+
+    shared = (escdf_shared_t *) malloc(sizeof(escdf_shared_t));
+    FULFILL_OR_RETURN_VAL(shared != NULL, ESCDF_ENOMEM, NULL);
+
+    /* the whole dataset is read, as in escdf_dataset_read_simple() */
+    nelems = (data->is_time_series) ? data->number_of_frames : 1;
+    for (i = 0; i < data->specs->ndims; i++) {
+        nelems *= data->dims[i];
+    }
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+    shared->size = nelems * ((mem_type_id == H5T_C_S1) ? data->specs->stringlength :
+                             H5Tget_size(mem_type_id));
+
+#ifdef HAVE_MPI
+    shared->win = MPI_WIN_NULL;
+    if (handle->node_comm != MPI_COMM_NULL) {
+        /* the memory is allocated on the first rank of the node only */
+        MPI_Comm_rank(handle->node_comm, &node_rank);
+        MPI_Win_allocate_shared((node_rank == 0) ? (MPI_Aint)shared->size : 0, 1,
+                                MPI_INFO_NULL, handle->node_comm, &shared->data, &shared->win);
+        MPI_Win_shared_query(shared->win, 0, &size, &disp_unit, &shared->data);
+
+        /* the reading rank uses an independent transfer, whatever the
+           mode of the dataset, on the dataset opened again with
+           independent metadata reads, since the other ranks do not
+           join the collective ones of the file */
+        err = ESCDF_SUCCESS;
+        MPI_Win_fence(0, shared->win);
+        if (node_rank == 0 && shared->size > 0) {
+            tmp = *data;
+            tmp.xfer_id = -1;
+            if ((err = utils_hdf5_open_dataset_independent(data->dtset_id, &tmp.dtset_id)) == ESCDF_SUCCESS) {
+                if ((tmp.xfer_id = escdf_transfer_create(ESCDF_TRANSFER_INDEPENDENT)) < 0) {
+                    err = ESCDF_ERROR;
+                } else {
+                    err = escdf_dataset_read_simple(&tmp, shared->data);
+                }
+                utils_hdf5_close_dataset(tmp.dtset_id);
+            }
+            if (tmp.xfer_id >= 0 && tmp.xfer_id != H5P_DEFAULT) {
+                H5Pclose(tmp.xfer_id);
+            }
+        }
+        MPI_Win_fence(0, shared->win);
+        MPI_Bcast(&err, 1, MPI_INT, 0, handle->node_comm);
+
+        if (err != ESCDF_SUCCESS) {
+            escdf_shared_free(shared);
+            DEFER_FUNC_ERROR(err);
+            return NULL;
+        }
+        return shared;
+    }
+#endif
+
+    /* an empty dataset has nothing to read */
+    shared->data = NULL;
+    if (shared->size == 0) {
+        return shared;
+    }
+    if ((shared->data = malloc(shared->size)) == NULL) {
+        free(shared);
+        DEFER_FUNC_ERROR(ESCDF_ENOMEM);
+        return NULL;
+    }
+    if ((err = escdf_dataset_read_simple(data, shared->data)) != ESCDF_SUCCESS) {
+        escdf_shared_free(shared);
+        DEFER_FUNC_ERROR(err);
+        return NULL;
+    }
+    return shared;
+}
+
+const void * escdf_shared_get_data(const escdf_shared_t *shared)
+{
+    FULFILL_OR_RETURN_VAL(shared != NULL, ESCDF_EOBJECT, NULL);
+
+    return shared->data;
+}
+
+size_t escdf_shared_get_size(const escdf_shared_t *shared)
+{
+    FULFILL_OR_RETURN_VAL(shared != NULL, ESCDF_EOBJECT, 0);
+
+    return shared->size;
+}
+
+void escdf_shared_free(escdf_shared_t *shared)
+{
+    if (shared == NULL) {
+        return;
+    }
+#ifdef HAVE_MPI
+    if (shared->win != MPI_WIN_NULL) {
+        MPI_Win_free(&shared->win);
+        free(shared);
+        return;
+    }
+#endif
+    free(shared->data);
+    free(shared);
+}
+
 escdf_errno_t escdf_dataset_read(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, void *buf)
+{
+    return escdf_dataset_read_mem(data, start, count, stride, buf, NULL, 0, NULL, NULL, NULL);
+}
+
+escdf_errno_t escdf_dataset_read_transfer(const escdf_dataset_t *data, escdf_transfer_mode_t mode,
+                                          const size_t *start, const size_t *count, const size_t *stride,
+                                          void *buf)
+{
+    escdf_dataset_t tmp;
+    escdf_errno_t err;
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(mode >= ESCDF_TRANSFER_DEFAULT && mode < ESCDF_N_TRANSFER_MODES, ESCDF_ERANGE);
+
+    tmp = *data;
+    FULFILL_OR_RETURN((tmp.xfer_id = escdf_transfer_create(mode)) >= 0, ESCDF_ERROR);
+    err = escdf_dataset_read(&tmp, start, count, stride, buf);
+    if (tmp.xfer_id != H5P_DEFAULT) {
+        H5Pclose(tmp.xfer_id);
+    }
+    return err;
+}
+
+/* The selections of utils_hdf5 are given in HDF5 sizes. */
+static hsize_t *_escdf_dataset_hsizes(const size_t *values, size_t n)
+{
+    hsize_t *hvalues;
+    size_t i;
+
+    if (values == NULL) {
+        return NULL;
+    }
+    hvalues = (hsize_t *) malloc(n * sizeof(hsize_t));
+    for (i = 0; i < n; i++) {
+        hvalues[i] = values[i];
+    }
+    return hvalues;
+}
+
+escdf_errno_t escdf_dataset_read_mem(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, void *buf,
+                                     const size_t *mem_dims, unsigned int mem_ndims,
+                                     const size_t *mem_start, const size_t *mem_count, const size_t *mem_stride)
 {
     hid_t mem_type_id;
+    escdf_errno_t err;
     bool compact;
+    unsigned int ndims;
     size_t start_compact[1];
     size_t count_compact[1];
     size_t stride_compact[1];
     const size_t *start_ptr, *count_ptr, *stride_ptr;
+    hsize_t *start_, *count_, *stride_, *mem_dims_, *mem_start_, *mem_count_, *mem_stride_;
 
     assert(data != NULL);
     assert(buf != NULL);
@@ -460,11 +714,13 @@ escdf_errno_t escdf_dataset_read(const escdf_dataset_t *data, const size_t *star
         start_ptr = start_compact;
         count_ptr = count_compact;
         stride_ptr = stride_compact;
+        ndims = 1;
 
     }  else {
         start_ptr = start;
         count_ptr = count;
         stride_ptr = stride;
+        ndims = data->specs->ndims;
     }
 
     mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
@@ -475,11 +731,245 @@ escdf_errno_t escdf_dataset_read(const escdf_dataset_t *data, const size_t *star
         H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
     }
 
-    utils_hdf5_read_dataset(data->dtset_id, data->xfer_id, buf, mem_type_id, start_ptr, count_ptr, stride_ptr);
+    start_ = _escdf_dataset_hsizes(start_ptr, ndims);
+    count_ = _escdf_dataset_hsizes(count_ptr, ndims);
+    stride_ = _escdf_dataset_hsizes(stride_ptr, ndims);
+    mem_dims_ = _escdf_dataset_hsizes(mem_dims, mem_ndims);
+    mem_start_ = _escdf_dataset_hsizes(mem_start, mem_ndims);
+    mem_count_ = _escdf_dataset_hsizes(mem_count, mem_ndims);
+    mem_stride_ = _escdf_dataset_hsizes(mem_stride, mem_ndims);
+
+    err = utils_hdf5_read_dataset_mem(data->dtset_id, data->xfer_id, buf, mem_type_id, start_, count_, stride_,
+                                      mem_dims_, mem_ndims, mem_start_, mem_count_, mem_stride_);
+
+    free(start_);
+    free(count_);
+    free(stride_);
+    free(mem_dims_);
+    free(mem_start_);
+    free(mem_count_);
+    free(mem_stride_);
+
+    return err;
+}
+
+/* In case of compact storage, row i of the [i][j] space is stored
+   on disk at the flat offset index_array[i]. */
+static escdf_errno_t _escdf_dataset_compact_row(const escdf_dataset_t *data, size_t row,
+                                                size_t *offset, size_t *length)
+{
+    unsigned int nrows;
+
+    if (escdf_attribute_get(data->dims_attr[0], &nrows) != ESCDF_SUCCESS) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    FULFILL_OR_RETURN(row < nrows, ESCDF_ERANGE);
+
+    *offset = data->index_array[row];
+    *length = ((row + 1 < nrows) ? data->index_array[row + 1] : data->dims[0]) - *offset;
 
     return ESCDF_SUCCESS;
 }
 
+/* In case of compact storage, boxes are given in the [i][j] space, and
+   mapped into the flat on-disk index space, one run per row of each box. */
+static escdf_errno_t _escdf_dataset_compact_boxes(const escdf_dataset_t *data, size_t nboxes,
+                                                  const size_t *start, const size_t *count, const size_t *stride,
+                                                  size_t *nruns, hsize_t **start_compact,
+                                                  hsize_t **count_compact, hsize_t **stride_compact)
+{
+    escdf_errno_t err;
+    size_t ibox, irow, irun, row, row_stride, col_stride;
+    size_t offset = 0, length = 0;
+
+    *nruns = 0;
+    for (ibox = 0; ibox < nboxes; ibox++) {
+        *nruns += count[ibox * 2 + 0];
+    }
+
+    *start_compact = (hsize_t *) malloc((*nruns + 1) * sizeof(hsize_t));
+    *count_compact = (hsize_t *) malloc((*nruns + 1) * sizeof(hsize_t));
+    *stride_compact = (hsize_t *) malloc((*nruns + 1) * sizeof(hsize_t));
+    if (*start_compact == NULL || *count_compact == NULL || *stride_compact == NULL) {
+        err = escdf_error_add(ESCDF_ENOMEM, __FILE__, __LINE__, __func__);
+        goto cleanup;
+    }
+
+    err = ESCDF_SUCCESS;
+    irun = 0;
+    for (ibox = 0; ibox < nboxes && err == ESCDF_SUCCESS; ibox++) {
+        row_stride = (stride != NULL) ? stride[ibox * 2 + 0] : 1;
+        col_stride = (stride != NULL) ? stride[ibox * 2 + 1] : 1;
+        for (irow = 0; irow < count[ibox * 2 + 0]; irow++, irun++) {
+            row = start[ibox * 2 + 0] + irow * row_stride;
+            if ((err = _escdf_dataset_compact_row(data, row, &offset, &length)) != ESCDF_SUCCESS) {
+                break;
+            }
+            if (count[ibox * 2 + 1] > 0 &&
+                start[ibox * 2 + 1] + (count[ibox * 2 + 1] - 1) * col_stride >= length) {
+                err = escdf_error_add(ESCDF_ERANGE, __FILE__, __LINE__, __func__);
+                break;
+            }
+            (*start_compact)[irun] = offset + start[ibox * 2 + 1];
+            (*count_compact)[irun] = count[ibox * 2 + 1];
+            (*stride_compact)[irun] = col_stride;
+        }
+    }
+
+cleanup:
+    if (err != ESCDF_SUCCESS) {
+        free(*start_compact);
+        free(*count_compact);
+        free(*stride_compact);
+        *start_compact = *count_compact = *stride_compact = NULL;
+    }
+    return err;
+}
+
+escdf_errno_t escdf_dataset_read_boxes(const escdf_dataset_t *data, size_t nboxes,
+                                       const size_t *start, const size_t *count, const size_t *stride, void *buf)
+{
+    hid_t mem_type_id;
+    escdf_errno_t err;
+    hsize_t *start_compact = NULL, *count_compact = NULL, *stride_compact = NULL;
+    hsize_t *start_, *count_, *stride_;
+    size_t n, nruns;
+
+    assert(data != NULL);
+    assert(buf != NULL);
+
+    if (data->dtset_id == ESCDF_UNDEFINED_ID) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    if (!data->is_ordered && data->transfer == NULL) {
+	RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+
+    if (mem_type_id == H5T_C_S1) {
+        mem_type_id = H5Tcopy(H5T_C_S1);
+        H5Tset_size(mem_type_id, data->specs->stringlength);
+        H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
+    }
+
+    if (escdf_dataset_specs_is_compact(data->specs)) {
+        if ((err = _escdf_dataset_compact_boxes(data, nboxes, start, count, stride, &nruns,
+                                                &start_compact, &count_compact,
+                                                &stride_compact)) != ESCDF_SUCCESS) {
+            return err;
+        }
+        err = utils_hdf5_read_dataset_boxes(data->dtset_id, data->xfer_id, buf, mem_type_id,
+                                            nruns, start_compact, count_compact, stride_compact);
+        free(start_compact);
+        free(count_compact);
+        free(stride_compact);
+    } else {
+        n = nboxes * data->specs->ndims;
+        start_ = _escdf_dataset_hsizes(start, n);
+        count_ = _escdf_dataset_hsizes(count, n);
+        stride_ = _escdf_dataset_hsizes(stride, n);
+        err = utils_hdf5_read_dataset_boxes(data->dtset_id, data->xfer_id, buf, mem_type_id,
+                                            nboxes, start_, count_, stride_);
+        free(start_);
+        free(count_);
+        free(stride_);
+    }
+
+    return err;
+}
+
+/* To limit the size of the coordinate array given to HDF5, at most
+   MAX_POINTS_BLOCK_SIZE points are read at once. */
+#define MAX_POINTS_BLOCK_SIZE (1024 * 1024)
+
+escdf_errno_t escdf_dataset_read_points(const escdf_dataset_t *data, size_t num_points, const size_t *coord, void *buf)
+{
+    hid_t mem_type_id;
+    escdf_errno_t err;
+    bool compact;
+    unsigned int ndims, ndims_disk, i, i0;
+    size_t j0, j, blocksize, elem_size, offset, length;
+    const size_t *point;
+    size_t *coord_disk;
+
+    assert(data != NULL);
+    assert(num_points == 0 || (coord != NULL && buf != NULL));
+
+    if (data->dtset_id == ESCDF_UNDEFINED_ID) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    if (!data->is_ordered && data->transfer == NULL) {
+	RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    compact = escdf_dataset_specs_is_compact(data->specs);
+    ndims = data->specs->ndims;
+    /* For a time series, the first index of each point is the frame. */
+    i0 = (data->is_time_series) ? 1 : 0;
+    ndims += i0;
+    ndims_disk = (compact) ? i0 + 1 : ndims;
+
+    for (j = 0; j < num_points; j++) {
+        point = coord + j * ndims;
+        if (data->is_time_series) {
+            FULFILL_OR_RETURN(point[0] < data->number_of_frames, ESCDF_ERANGE);
+        }
+        if (compact) {
+            SUCCEED_OR_RETURN(_escdf_dataset_compact_row(data, point[i0], &offset, &length));
+            FULFILL_OR_RETURN(point[i0 + 1] < length, ESCDF_ERANGE);
+        } else {
+            for (i = i0; i < ndims; i++) {
+                FULFILL_OR_RETURN(point[i] < data->dims[i - i0], ESCDF_ERANGE);
+            }
+        }
+    }
+
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+
+    if (mem_type_id == H5T_C_S1) {
+        mem_type_id = H5Tcopy(H5T_C_S1);
+        H5Tset_size(mem_type_id, data->specs->stringlength);
+        H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
+    }
+    elem_size = H5Tget_size(mem_type_id);
+
+    if (num_points == 0) {
+        return utils_hdf5_read_dataset_at(data->dtset_id, data->xfer_id, buf, mem_type_id, 0, NULL);
+    }
+
+    blocksize = (num_points < MAX_POINTS_BLOCK_SIZE) ? num_points : MAX_POINTS_BLOCK_SIZE;
+    coord_disk = (size_t *) malloc(blocksize * ndims_disk * sizeof(size_t));
+    FULFILL_OR_RETURN(coord_disk != NULL, ESCDF_ENOMEM);
+
+    err = ESCDF_SUCCESS;
+    for (j0 = 0; j0 < num_points && err == ESCDF_SUCCESS; j0 += blocksize) {
+        if (num_points - j0 < blocksize) {
+            blocksize = num_points - j0;
+        }
+        if (compact) {
+            /* (i, j) maps into the flat on-disk index space, after the frame if any. */
+            for (j = 0; j < blocksize; j++) {
+                point = coord + (j0 + j) * ndims;
+                if (data->is_time_series) {
+                    coord_disk[j * ndims_disk] = point[0];
+                }
+                coord_disk[j * ndims_disk + i0] = data->index_array[point[i0]] + point[i0 + 1];
+            }
+        } else {
+            memcpy(coord_disk, coord + j0 * ndims, blocksize * ndims * sizeof(size_t));
+        }
+        err = utils_hdf5_read_dataset_at(data->dtset_id, data->xfer_id,
+                                         (char *)buf + j0 * elem_size, mem_type_id,
+                                         blocksize, coord_disk);
+    }
+    free(coord_disk);
+
+    return err;
+}
+
 escdf_errno_t escdf_dataset_read_simple(const escdf_dataset_t *data, void *buf)
 {
     unsigned int i;
@@ -505,6 +995,11 @@ escdf_errno_t escdf_dataset_read_simple(const escdf_dataset_t *data, void *buf)
         H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
     }
 
+    /* a time series is read as a whole, all frames included */
+    if (data->is_time_series) {
+        return utils_hdf5_read_dataset(data->dtset_id, data->xfer_id, buf, mem_type_id, NULL, NULL, NULL);
+    }
+
     start = (size_t *) malloc(data->specs->ndims * sizeof(size_t));
     count = (size_t *) malloc(data->specs->ndims * sizeof(size_t));
     stride = (size_t *) malloc(data->specs->ndims * sizeof(size_t));
@@ -537,6 +1032,11 @@ escdf_errno_t escdf_dataset_write_simple(escdf_dataset_t *data, const void *buf)
         RETURN_WITH_ERROR(ESCDF_ERROR);
     }
 
+    /* frames of a time series are written with escdf_dataset_append_frame() */
+    if (data->is_time_series) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
     start = (size_t *) malloc(data->specs->ndims * sizeof(unsigned int));
     count = (size_t *) malloc(data->specs->ndims * sizeof(unsigned int));
     stride = (size_t *) malloc(data->specs->ndims * sizeof(unsigned int));
@@ -571,13 +1071,174 @@ escdf_errno_t escdf_dataset_write_simple(escdf_dataset_t *data, const void *buf)
 }
 
 escdf_errno_t escdf_dataset_write(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, const void *buf)
+{
+    return escdf_dataset_write_mem(data, start, count, stride, buf, NULL, 0, NULL, NULL, NULL);
+}
+
+/* The per-call variants work on a shallow copy of data holding the
+   transfer property list of the call. */
+escdf_errno_t escdf_dataset_write_transfer(const escdf_dataset_t *data, escdf_transfer_mode_t mode,
+                                           const size_t *start, const size_t *count, const size_t *stride,
+                                           const void *buf)
+{
+    escdf_dataset_t tmp;
+    escdf_errno_t err;
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(mode >= ESCDF_TRANSFER_DEFAULT && mode < ESCDF_N_TRANSFER_MODES, ESCDF_ERANGE);
+
+    tmp = *data;
+    FULFILL_OR_RETURN((tmp.xfer_id = escdf_transfer_create(mode)) >= 0, ESCDF_ERROR);
+    err = escdf_dataset_write(&tmp, start, count, stride, buf);
+    if (tmp.xfer_id != H5P_DEFAULT) {
+        H5Pclose(tmp.xfer_id);
+    }
+    return err;
+}
+
+escdf_errno_t escdf_dataset_write_aggregated(const escdf_dataset_t *data, const escdf_handle_t *handle,
+                                             const size_t *start, const size_t *count, const size_t *stride,
+                                             const void *buf)
+{
+#ifdef HAVE_MPI
+    escdf_dataset_t tmp;
+    escdf_errno_t err;
+    unsigned long long int *sel, *gsel;
+    unsigned int i, ndims, nsel;
+    int grank, gsize, g;
+    size_t nelems, elem_size, *counts, *displs, *sstart, *scount, *sstride;
+    hid_t mem_type_id, dcpl_id;
+    int nfilters;
+    char *gbuf;
+#endif
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(handle != NULL, ESCDF_EOBJECT);
+
+#ifdef HAVE_MPI
+    if (handle->mpi_size == 1 || handle->agg_comm == MPI_COMM_NULL) {
+        return escdf_dataset_write(data, start, count, stride, buf);
+    }
+
+    /* Parallel HDF5 only writes filtered datasets collectively, so the
+       aggregators cannot write them alone. */
+    if ((dcpl_id = H5Dget_create_plist(data->dtset_id)) < 0) {
+        RETURN_WITH_ERROR(dcpl_id);
+    }
+    nfilters = H5Pget_nfilters(dcpl_id);
+    H5Pclose(dcpl_id);
+    FULFILL_OR_RETURN(nfilters >= 0, ESCDF_ERROR);
+    if (nfilters > 0) {
+        return escdf_dataset_write_transfer(data, ESCDF_TRANSFER_COLLECTIVE,
+                                            start, count, stride, buf);
+    }
+
+    FULFILL_OR_RETURN(start != NULL && count != NULL, ESCDF_EVALUE);
+
+    ndims = data->specs->ndims + (data->is_time_series ? 1 : 0);
+
+    /* Size of the local block, compact storage being written as rows. */
+    if (escdf_dataset_specs_is_compact(data->specs)) {
+        nelems = count[1];
+    } else {
+        nelems = 1;
+        for (i = 0; i < ndims; i++) {
+            nelems *= count[i];
+        }
+    }
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+    elem_size = (mem_type_id == H5T_C_S1) ? data->specs->stringlength : H5Tget_size(mem_type_id);
+
+    /* Gather the selections and block sizes, then the data, on the
+       aggregator. Sizes and offsets are kept as size_t, since the data
+       of a group easily exceeds what an int can count. */
+    MPI_Comm_rank(handle->agg_comm, &grank);
+    MPI_Comm_size(handle->agg_comm, &gsize);
+    nsel = 3 * ndims + 1;
+    sel = (unsigned long long int *) malloc(nsel * sizeof(unsigned long long int));
+    for (i = 0; i < ndims; i++) {
+        sel[i] = start[i];
+        sel[ndims + i] = count[i];
+        sel[2 * ndims + i] = (stride) ? stride[i] : 1;
+    }
+    sel[3 * ndims] = nelems * elem_size;
+    gsel = NULL;
+    counts = displs = NULL;
+    gbuf = NULL;
+    if (grank == 0) {
+        gsel = (unsigned long long int *) malloc(nsel * gsize * sizeof(unsigned long long int));
+        counts = (size_t *) malloc(gsize * sizeof(size_t));
+        displs = (size_t *) malloc(gsize * sizeof(size_t));
+    }
+    MPI_Gather(sel, nsel, MPI_UNSIGNED_LONG_LONG, gsel, nsel, MPI_UNSIGNED_LONG_LONG,
+               0, handle->agg_comm);
+    free(sel);
+    if (grank == 0) {
+        for (g = 0; g < gsize; g++) {
+            counts[g] = gsel[nsel * g + 3 * ndims];
+            displs[g] = (g > 0) ? displs[g - 1] + counts[g - 1] : 0;
+        }
+        gbuf = (char *) malloc(displs[gsize - 1] + counts[gsize - 1]);
+    }
+    _gather_bytes(buf, nelems * elem_size, gbuf, counts, displs, handle->agg_comm);
+
+    /* The aggregator writes the blocks one after the other, with
+       independent transfers since groups issue different numbers of
+       writes. The dataset is opened again with independent metadata
+       reads, the file using collective ones that the other ranks would
+       never join. */
+    err = ESCDF_SUCCESS;
+    if (grank == 0) {
+        tmp = *data;
+        tmp.xfer_id = -1;
+        if ((err = utils_hdf5_open_dataset_independent(data->dtset_id, &tmp.dtset_id)) == ESCDF_SUCCESS &&
+            (tmp.xfer_id = escdf_transfer_create(ESCDF_TRANSFER_INDEPENDENT)) < 0) {
+            err = ESCDF_ERROR;
+        }
+        sstart = (size_t *) malloc(3 * ndims * sizeof(size_t));
+        scount = sstart + ndims;
+        sstride = sstart + 2 * ndims;
+        for (g = 0; g < gsize && err == ESCDF_SUCCESS; g++) {
+            for (i = 0; i < ndims; i++) {
+                sstart[i] = gsel[nsel * g + i];
+                scount[i] = gsel[nsel * g + ndims + i];
+                sstride[i] = gsel[nsel * g + 2 * ndims + i];
+            }
+            err = escdf_dataset_write(&tmp, sstart, scount, sstride, gbuf + displs[g]);
+        }
+        free(sstart);
+        if (tmp.xfer_id >= 0 && tmp.xfer_id != H5P_DEFAULT) {
+            H5Pclose(tmp.xfer_id);
+        }
+        if (tmp.dtset_id >= 0 && tmp.dtset_id != data->dtset_id) {
+            utils_hdf5_close_dataset(tmp.dtset_id);
+        }
+        free(gsel);
+        free(counts);
+        free(displs);
+        free(gbuf);
+    }
+    MPI_Bcast(&err, 1, MPI_INT, 0, handle->agg_comm);
+
+    return err;
+#else
+    return escdf_dataset_write(data, start, count, stride, buf);
+#endif
+}
+
+escdf_errno_t escdf_dataset_write_mem(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, const void *buf,
+                                      const size_t *mem_dims, unsigned int mem_ndims,
+                                      const size_t *mem_start, const size_t *mem_count, const size_t *mem_stride)
 {
     hid_t mem_type_id;
+    escdf_errno_t err;
     bool compact;
+    unsigned int ndims;
     size_t start_compact[1];
     size_t count_compact[1];
     size_t stride_compact[1];
     const size_t *start_ptr, *count_ptr, *stride_ptr;
+    hsize_t *start_, *count_, *stride_, *mem_dims_, *mem_start_, *mem_count_, *mem_stride_;
 
     assert(data != NULL);
 
@@ -600,10 +1261,12 @@ escdf_errno_t escdf_dataset_write(const escdf_dataset_t *data, const size_t *sta
         start_ptr = start_compact;
         count_ptr = count_compact;
         stride_ptr = stride_compact;
+        ndims = 1;
     } else {
         start_ptr = start;
         count_ptr = count;
         stride_ptr = stride;
+        ndims = data->specs->ndims;
     }
 
     mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
@@ -614,11 +1277,158 @@ escdf_errno_t escdf_dataset_write(const escdf_dataset_t *data, const size_t *sta
         H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
     }
 
-    return utils_hdf5_write_dataset(data->dtset_id, data->xfer_id, buf, mem_type_id, start_ptr, count_ptr, stride_ptr);
+    start_ = _escdf_dataset_hsizes(start_ptr, ndims);
+    count_ = _escdf_dataset_hsizes(count_ptr, ndims);
+    stride_ = _escdf_dataset_hsizes(stride_ptr, ndims);
+    mem_dims_ = _escdf_dataset_hsizes(mem_dims, mem_ndims);
+    mem_start_ = _escdf_dataset_hsizes(mem_start, mem_ndims);
+    mem_count_ = _escdf_dataset_hsizes(mem_count, mem_ndims);
+    mem_stride_ = _escdf_dataset_hsizes(mem_stride, mem_ndims);
+
+    err = utils_hdf5_write_dataset_mem(data->dtset_id, data->xfer_id, buf, mem_type_id, start_, count_, stride_,
+                                       mem_dims_, mem_ndims, mem_start_, mem_count_, mem_stride_);
+
+    free(start_);
+    free(count_);
+    free(stride_);
+    free(mem_dims_);
+    free(mem_start_);
+    free(mem_count_);
+    free(mem_stride_);
+
+    return err;
 }
 
 
 
+escdf_errno_t escdf_dataset_write_boxes(const escdf_dataset_t *data, size_t nboxes,
+                                        const size_t *start, const size_t *count, const size_t *stride, const void *buf)
+{
+    hid_t mem_type_id;
+    escdf_errno_t err;
+    hsize_t *start_compact = NULL, *count_compact = NULL, *stride_compact = NULL;
+    hsize_t *start_, *count_, *stride_;
+    size_t n, nruns;
+
+    assert(data != NULL);
+
+    if (data->dtset_id == ESCDF_UNDEFINED_ID) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    if (!data->is_ordered) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+
+    if(mem_type_id == H5T_C_S1) {
+        mem_type_id = H5Tcopy(H5T_C_S1);
+        H5Tset_size(mem_type_id, data->specs->stringlength);
+        H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
+    }
+
+    if (escdf_dataset_specs_is_compact(data->specs)) {
+        if ((err = _escdf_dataset_compact_boxes(data, nboxes, start, count, stride, &nruns,
+                                                &start_compact, &count_compact,
+                                                &stride_compact)) != ESCDF_SUCCESS) {
+            return err;
+        }
+        err = utils_hdf5_write_dataset_boxes(data->dtset_id, data->xfer_id, buf, mem_type_id,
+                                             nruns, start_compact, count_compact, stride_compact);
+        free(start_compact);
+        free(count_compact);
+        free(stride_compact);
+    } else {
+        n = nboxes * data->specs->ndims;
+        start_ = _escdf_dataset_hsizes(start, n);
+        count_ = _escdf_dataset_hsizes(count, n);
+        stride_ = _escdf_dataset_hsizes(stride, n);
+        err = utils_hdf5_write_dataset_boxes(data->dtset_id, data->xfer_id, buf, mem_type_id,
+                                             nboxes, start_, count_, stride_);
+        free(start_);
+        free(count_);
+        free(stride_);
+    }
+
+    return err;
+}
+
+escdf_errno_t escdf_dataset_append_frame(escdf_dataset_t *data, const void *buf)
+{
+    hid_t mem_type_id;
+    size_t frame;
+
+    assert(data != NULL);
+    assert(buf != NULL);
+
+    if (data->dtset_id == ESCDF_UNDEFINED_ID || !data->is_time_series) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    if (!data->is_ordered) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+
+    if(mem_type_id == H5T_C_S1) {
+        mem_type_id = H5Tcopy(H5T_C_S1);
+        H5Tset_size(mem_type_id, data->specs->stringlength);
+        H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
+    }
+
+    SUCCEED_OR_RETURN(utils_hdf5_append_frame(data->dtset_id, data->xfer_id, buf, mem_type_id, &frame));
+    data->number_of_frames = frame + 1;
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_dataset_read_frame(const escdf_dataset_t *data, size_t frame, void *buf)
+{
+    hid_t mem_type_id;
+    unsigned int i;
+    size_t *start, *count;
+    escdf_errno_t err;
+
+    assert(data != NULL);
+    assert(buf != NULL);
+
+    if (data->dtset_id == ESCDF_UNDEFINED_ID || !data->is_time_series) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    if (!data->is_ordered && data->transfer == NULL) {
+	RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    FULFILL_OR_RETURN(frame < data->number_of_frames, ESCDF_ERANGE);
+
+    mem_type_id = utils_hdf5_mem_type(data->specs->datatype);
+
+    if (mem_type_id == H5T_C_S1) {
+        mem_type_id = H5Tcopy(H5T_C_S1);
+        H5Tset_size(mem_type_id, data->specs->stringlength);
+        H5Tset_strpad(mem_type_id, H5T_STR_NULLTERM);
+    }
+
+    start = (size_t *) malloc((data->ndims_effective + 1) * sizeof(size_t));
+    count = (size_t *) malloc((data->ndims_effective + 1) * sizeof(size_t));
+    start[0] = frame;
+    count[0] = 1;
+    for (i = 0; i < data->ndims_effective; i++) {
+        start[i + 1] = 0;
+        count[i + 1] = data->dims[i];
+    }
+
+    err = utils_hdf5_read_dataset(data->dtset_id, data->xfer_id, buf, mem_type_id, start, count, NULL);
+    free(start);
+    free(count);
+
+    return err;
+}
+
+
 /**********************************************************************************************/
 /**********************************************************************************************/
 /**********************************************************************************************/
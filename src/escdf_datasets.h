@@ -160,6 +160,61 @@ const size_t * escdf_dataset_get_dimensions(const escdf_dataset_t *data);
  */
 escdf_errno_t escdf_dataset_set_ordered(escdf_dataset_t *data, bool ordered);
 
+/**
+ * @brief get the transfer mode used for the data transfers of the dataset
+ * 
+ * @param[in] data 
+ * @return escdf_transfer_mode_t 
+ */
+escdf_transfer_mode_t escdf_dataset_get_transfer_mode(const escdf_dataset_t *data);
+
+/**
+ * @brief set the transfer mode used for the data transfers of the dataset
+ * 
+ * By default, the HDF5 default transfer is used, which is independent with
+ * MPI-IO. Small replicated datasets are better read independently, while
+ * large distributed ones benefit from collective transfers.
+ * 
+ * @param[inout] data 
+ * @param[in] mode 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_set_transfer_mode(escdf_dataset_t *data, escdf_transfer_mode_t mode);
+
+/**
+ * @brief query whether the dataset is a time series
+ * 
+ * @param[in] data 
+ * @return true 
+ * @return false 
+ */
+bool escdf_dataset_is_time_series(const escdf_dataset_t *data);
+
+/**
+ * @brief set the time series flag, before the dataset is created
+ * 
+ * A time series is stored with an additional, unlimited, leading
+ * dimension indexing the frames, and one chunk per frame, so that
+ * frames can be appended one at a time with
+ * escdf_dataset_append_frame(). The dimensions derived from the
+ * attributes apply to each frame. In escdf_dataset_read() and
+ * escdf_dataset_write(), start, count and stride include the frame
+ * dimension first. Compact storage cannot be used for time series.
+ * 
+ * @param[inout] data 
+ * @param[in] time_series 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_set_time_series(escdf_dataset_t *data, bool time_series);
+
+/**
+ * @brief get the number of frames of a time series
+ * 
+ * @param[in] data 
+ * @return size_t 
+ */
+size_t escdf_dataset_get_number_of_frames(const escdf_dataset_t *data);
+
 /**
  * @brief Get pointer to the dataset holding the reordering table.
  * 
@@ -270,6 +325,196 @@ escdf_errno_t escdf_dataset_read(const escdf_dataset_t *data, const size_t *star
  */
 escdf_errno_t escdf_dataset_write(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, const void *buf);
 
+/**
+ * @brief same as escdf_dataset_read() and escdf_dataset_write(), with a
+ * transfer mode for this call only, overriding the one of the dataset
+ */
+escdf_errno_t escdf_dataset_read_transfer(const escdf_dataset_t *data, escdf_transfer_mode_t mode,
+                                          const size_t *start, const size_t *count, const size_t *stride,
+                                          void *buf);
+escdf_errno_t escdf_dataset_write_transfer(const escdf_dataset_t *data, escdf_transfer_mode_t mode,
+                                           const size_t *start, const size_t *count, const size_t *stride,
+                                           const void *buf);
+
+/**
+ * @brief same as escdf_dataset_write(), the blocks of the ranks of each
+ * aggregation group of the handle being gathered and written by its
+ * aggregator, see escdf_handle_set_aggregation()
+ * 
+ * Without aggregation, this is escdf_dataset_write(). Otherwise, this is
+ * a collective call, start and count must be given, and the aggregators
+ * write with independent transfers. Filtered (e.g. compressed) datasets,
+ * which parallel HDF5 only writes collectively, are not aggregated: every
+ * rank writes its block with a collective escdf_dataset_write().
+ * 
+ * @param data 
+ * @param handle 
+ * @param start 
+ * @param count 
+ * @param stride 
+ * @param buf 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_write_aggregated(const escdf_dataset_t *data, const escdf_handle_t *handle,
+                                             const size_t *start, const size_t *count, const size_t *stride,
+                                             const void *buf);
+
+/**
+ * @brief read-only copy of a whole dataset, possibly shared by the ranks of a node
+ */
+typedef struct escdf_shared escdf_shared_t;
+
+/**
+ * @brief read the whole dataset, as escdf_dataset_read_simple(), for data
+ * replicated on all ranks
+ * 
+ * When node sharing is set on the handle, see
+ * escdf_handle_set_node_sharing(), the dataset is read by one rank per node
+ * into MPI shared memory, and all the ranks of the node get a pointer to
+ * it, which must not be modified. This is then a collective call on the
+ * ranks of the node. Otherwise, each rank reads its own copy.
+ * 
+ * @param data 
+ * @param handle 
+ * @return the shared copy, to be freed with escdf_shared_free(), NULL on error
+ */
+escdf_shared_t * escdf_dataset_read_shared(const escdf_dataset_t *data, const escdf_handle_t *handle);
+
+/**
+ * @brief the values read by escdf_dataset_read_shared()
+ */
+const void * escdf_shared_get_data(const escdf_shared_t *shared);
+
+/**
+ * @brief the size in bytes of the values read by escdf_dataset_read_shared()
+ */
+size_t escdf_shared_get_size(const escdf_shared_t *shared);
+
+/**
+ * @brief free the copy, a collective call on the ranks of the node when shared
+ */
+void escdf_shared_free(escdf_shared_t *shared);
+
+/**
+ * @brief read from dataset *data into a sub-block of a larger buffer
+ * 
+ * The buffer is a dense array of shape mem_dims, and the values are
+ * placed in the hyperslab given by mem_start, mem_count and
+ * mem_stride (whole buffer if mem_start or mem_count is NULL).
+ * 
+ * @param data 
+ * @param start 
+ * @param count 
+ * @param stride 
+ * @param buf 
+ * @param mem_dims 
+ * @param mem_ndims 
+ * @param mem_start 
+ * @param mem_count 
+ * @param mem_stride 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_read_mem(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, void *buf,
+                                     const size_t *mem_dims, unsigned int mem_ndims,
+                                     const size_t *mem_start, const size_t *mem_count, const size_t *mem_stride);
+
+/**
+ * @brief write to dataset *data from a sub-block of a larger buffer
+ * 
+ * See escdf_dataset_read_mem() for the memory selection.
+ * 
+ * @param data 
+ * @param start 
+ * @param count 
+ * @param stride 
+ * @param buf 
+ * @param mem_dims 
+ * @param mem_ndims 
+ * @param mem_start 
+ * @param mem_count 
+ * @param mem_stride 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_write_mem(const escdf_dataset_t *data, const size_t *start, const size_t *count, const size_t *stride, const void *buf,
+                                      const size_t *mem_dims, unsigned int mem_ndims,
+                                      const size_t *mem_start, const size_t *mem_count, const size_t *mem_stride);
+
+/**
+ * @brief read the union of several boxes from dataset *data in one transfer
+ * 
+ * start, count and stride hold nboxes consecutive boxes, each of the
+ * rank of the dataset (stride may be NULL). Boxes must be disjoint.
+ * Values are stored in buf following the row-major order of the
+ * dataset over the union of the boxes.
+ * For compact storage, boxes are given in the [i][j] space and must
+ * fit within the length of each of their rows.
+ * 
+ * @param data 
+ * @param nboxes 
+ * @param start 
+ * @param count 
+ * @param stride 
+ * @param buf 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_read_boxes(const escdf_dataset_t *data, size_t nboxes,
+                                       const size_t *start, const size_t *count, const size_t *stride, void *buf);
+
+/**
+ * @brief write to the union of several boxes of dataset *data in one transfer
+ * 
+ * See escdf_dataset_read_boxes() for the layout of boxes and buffer.
+ * 
+ * @param data 
+ * @param nboxes 
+ * @param start 
+ * @param count 
+ * @param stride 
+ * @param buf 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_write_boxes(const escdf_dataset_t *data, size_t nboxes,
+                                        const size_t *start, const size_t *count, const size_t *stride, const void *buf);
+
+/**
+ * @brief read scattered elements from dataset *data
+ * 
+ * coord holds num_points consecutive sets of indices, each of the
+ * rank of the dataset. Values are stored in buf in the order of the
+ * points. Large lists of points are read in batches.
+ * For compact storage, points are given in the [i][j] space and each
+ * column is checked against the length of its row.
+ * 
+ * @param data 
+ * @param num_points 
+ * @param coord 
+ * @param buf 
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_read_points(const escdf_dataset_t *data, size_t num_points, const size_t *coord, void *buf);
+
+/**
+ * @brief append one frame to a time series
+ * 
+ * The dataset is extended by one frame, without rewriting the
+ * previous ones.
+ * 
+ * @param data 
+ * @param buf: values of one frame
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_append_frame(escdf_dataset_t *data, const void *buf);
+
+/**
+ * @brief read one frame of a time series
+ * 
+ * @param data 
+ * @param frame: index of the frame
+ * @param buf: values of the frame
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_dataset_read_frame(const escdf_dataset_t *data, size_t frame, void *buf);
+
 /**
  * @brief dump basic data to screen 
  * 
@@ -21,6 +21,7 @@
  */
 
 #include <math.h>
+#include <stdint.h>
 
 #include "escdf_grid_scalarfields.h"
 
@@ -44,6 +45,15 @@ struct _escdf_grid_scalarfield_t {
     _uint_set_t number_of_components;
     _uint_set_t real_or_complex;
     _bool_set_t use_default_ordering;
+    _uint_set_t storage_precision;
+    _bool_set_t use_complex_type;
+    _bool_set_t use_grid_layout;
+    unsigned int *grid_chunk_dims;
+    _uint_set_t number_of_levels;
+    _bool_set_t use_chunk_statistics;
+    _bool_set_t use_time_series;
+    _uint_set_t keyframe_interval;
+    _uint_set_t compression_level;
 
     /* The data */
     bool values_on_grid_is_present;
@@ -73,10 +83,412 @@ void escdf_grid_scalarfield_free(escdf_grid_scalarfield_t *scalarfield)
     free(scalarfield->cell.dimension_types);
     free(scalarfield->cell.lattice_vectors);
     free(scalarfield->number_of_grid_points);
+    free(scalarfield->grid_chunk_dims);
 
     free(scalarfield);
 }
 
+/* Complex values are either stored with a trailing dimension of
+   length 2, or as a compound {r, i} type, binary compatible with C99
+   double complex and C++ std::complex<double>. */
+static bool _use_complex_type(const escdf_grid_scalarfield_t *scalarfield)
+{
+    return scalarfield->real_or_complex.value == ESCDF_COMPLEX &&
+        scalarfield->use_complex_type.is_set && scalarfield->use_complex_type.value;
+}
+
+/* values_on_grid is either stored flattened, with shape
+   [number_of_components, number of grid points, real_or_complex], or
+   with one dimension per direction, [number_of_components, nz, ny, nx,
+   real_or_complex], so that it can be chunked in 3D. In both cases the
+   trailing dimension is absent with the compound complex type. */
+#define MAX_VALUES_ON_GRID_NDIMS 5
+#define DEFAULT_GRID_CHUNK_SIZE 32
+#define STATISTICS_BLOCK_SIZE 4096
+
+static bool _use_grid_layout(const escdf_grid_scalarfield_t *scalarfield)
+{
+    return scalarfield->use_grid_layout.is_set && scalarfield->use_grid_layout.value;
+}
+
+/* values_on_grid can be compressed with the shuffle and deflate
+   filters. Without the grid layout, it is then chunked along the grid
+   points with one chunk per block of the decomposition of
+   _get_block_slice(), split when larger than MAX_COMPRESSED_CHUNK_SIZE
+   bytes, so that each process of a redistributed write owns whole
+   chunks. */
+#define MAX_COMPRESSED_CHUNK_SIZE (1 << 26)
+
+static unsigned int _get_compression_level(const escdf_grid_scalarfield_t *scalarfield)
+{
+    return (scalarfield->compression_level.is_set) ? scalarfield->compression_level.value : 0;
+}
+
+/* Decomposition of npoints grid points in the default ordering over
+   size processes, in contiguous blocks of ceil(npoints / size) points,
+   the last processes possibly owning fewer or no points. */
+static hsize_t _get_block_size(hsize_t npoints, int size)
+{
+    return (npoints + size - 1) / size;
+}
+
+static void _get_block_slice(hsize_t npoints, int size, int rank,
+                             hsize_t *offset, hsize_t *len)
+{
+    hsize_t block;
+
+    block = _get_block_size(npoints, size);
+    *offset = (hsize_t)rank * block;
+    if (*offset > npoints) {
+        *offset = npoints;
+    }
+    *len = (npoints - *offset < block) ? npoints - *offset : block;
+}
+
+static int _get_block_owner(hsize_t npoints, int size, hsize_t index)
+{
+    return (int)(index / _get_block_size(npoints, size));
+}
+
+/* The transfer property list to write values_on_grid. HDF5 only
+   writes filtered datasets in parallel with collective transfers, so
+   one is created, to be closed by the caller, when the handle one is
+   not collective. */
+static hid_t _get_values_on_grid_xfer(const escdf_grid_scalarfield_t *scalarfield,
+                                      const escdf_handle_t *file_id)
+{
+#ifdef HAVE_MPI
+    H5FD_mpio_xfer_t mode;
+
+    if (file_id->mpi_size > 1 && _get_compression_level(scalarfield) > 0 &&
+        (file_id->transfer_mode == H5P_DEFAULT ||
+         H5Pget_dxpl_mpio(file_id->transfer_mode, &mode) < 0 ||
+         mode != H5FD_MPIO_COLLECTIVE)) {
+        return escdf_transfer_create(ESCDF_TRANSFER_COLLECTIVE);
+    }
+#else
+    (void)scalarfield;
+#endif
+    return file_id->transfer_mode;
+}
+
+static hsize_t _get_number_of_points(const escdf_grid_scalarfield_t *scalarfield)
+{
+    hsize_t len;
+    unsigned int i;
+
+    len = scalarfield->number_of_grid_points[0];
+    for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+        len *= scalarfield->number_of_grid_points[i];
+    }
+    return len;
+}
+
+static unsigned int _get_values_on_grid_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                             size_t *dims)
+{
+    unsigned int i, ndims;
+
+    ndims = 0;
+    dims[ndims++] = scalarfield->number_of_components.value;
+    if (_use_grid_layout(scalarfield)) {
+        for (i = scalarfield->cell.number_of_physical_dimensions.value; i > 0; i--) {
+            dims[ndims++] = scalarfield->number_of_grid_points[i - 1];
+        }
+    } else {
+        dims[ndims++] = _get_number_of_points(scalarfield);
+    }
+    if (!_use_complex_type(scalarfield)) {
+        dims[ndims++] = scalarfield->real_or_complex.value;
+    }
+    return ndims;
+}
+
+/* The chunk of the grid layout, in number_of_grid_points order. */
+static void _get_grid_chunk_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                 hsize_t *chunk)
+{
+    unsigned int i;
+
+    for (i = 0; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+        chunk[i] = (scalarfield->grid_chunk_dims) ?
+            scalarfield->grid_chunk_dims[i] : DEFAULT_GRID_CHUNK_SIZE;
+        if (chunk[i] > scalarfield->number_of_grid_points[i]) {
+            chunk[i] = scalarfield->number_of_grid_points[i];
+        }
+    }
+}
+
+typedef struct {
+    bool grid_layout;
+    unsigned int npd;
+    hsize_t n[3], chunk[3], nchunks[3];
+} _chunk_key_t;
+
+static void _init_chunk_key(const escdf_grid_scalarfield_t *scalarfield, _chunk_key_t *ck)
+{
+    unsigned int i;
+
+    ck->grid_layout = _use_grid_layout(scalarfield);
+    ck->npd = scalarfield->cell.number_of_physical_dimensions.value;
+    _get_grid_chunk_dims(scalarfield, ck->chunk);
+    for (i = 0; i < ck->npd; i++) {
+        ck->n[i] = scalarfield->number_of_grid_points[i];
+        ck->nchunks[i] = (ck->n[i] + ck->chunk[i] - 1) / ck->chunk[i];
+    }
+}
+
+/* The index of the chunk holding a grid point, x running fastest. */
+static hsize_t _get_chunk_index(const _chunk_key_t *ck, hsize_t ipoint)
+{
+    hsize_t g[3], cidx;
+    unsigned int i;
+
+    for (i = 0; i < ck->npd; i++) {
+        g[i] = ipoint % ck->n[i];
+        ipoint /= ck->n[i];
+    }
+    cidx = 0;
+    for (i = ck->npd; i > 0; i--) {
+        cidx = cidx * ck->nchunks[i - 1] + g[i - 1] / ck->chunk[i - 1];
+    }
+    return cidx;
+}
+
+/* Shape of the per-chunk statistics datasets:
+   [number_of_components, chunks along z, y, x, real_or_complex]. */
+static unsigned int _get_chunk_statistics_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                               size_t *dims)
+{
+    hsize_t chunk[3];
+    unsigned int i, npd, ndims;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    _get_grid_chunk_dims(scalarfield, chunk);
+    ndims = 0;
+    dims[ndims++] = scalarfield->number_of_components.value;
+    for (i = npd; i > 0; i--) {
+        dims[ndims++] = (scalarfield->number_of_grid_points[i - 1] + chunk[i - 1] - 1) / chunk[i - 1];
+    }
+    dims[ndims++] = scalarfield->real_or_complex.value;
+    return ndims;
+}
+
+/* Set the dataset coordinates of one value, given the grid point
+   index in the default zyx ordering. Returns the rank. */
+static unsigned int _get_point_coord(const escdf_grid_scalarfield_t *scalarfield,
+                                     size_t *coord, unsigned int icomp,
+                                     hsize_t ipoint, unsigned int icplx)
+{
+    unsigned int i, ndims, npd;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    ndims = 0;
+    coord[ndims++] = icomp;
+    if (_use_grid_layout(scalarfield)) {
+        for (i = 0; i < npd; i++) {
+            coord[npd - i] = ipoint % scalarfield->number_of_grid_points[i];
+            ipoint /= scalarfield->number_of_grid_points[i];
+        }
+        ndims += npd;
+    } else {
+        coord[ndims++] = ipoint;
+    }
+    if (!_use_complex_type(scalarfield)) {
+        coord[ndims++] = icplx;
+    }
+    return ndims;
+}
+
+/* Decompose the range [offset, offset + len[ of grid points in the
+   default ordering into at most 2 * number_of_physical_dimensions - 1
+   disjoint boxes of the values_on_grid dataset, covering all
+   components. The boxes are stored consecutively in start and count,
+   each of the rank of the dataset. Returns the number of boxes. */
+static size_t _get_range_boxes(const escdf_grid_scalarfield_t *scalarfield,
+                               hsize_t offset, hsize_t len,
+                               hsize_t *start, hsize_t *count)
+{
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    size_t coord[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t block[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t end, n, limit;
+    unsigned int ndims, npd, i, k;
+    size_t nboxes;
+
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    if (!_use_grid_layout(scalarfield)) {
+        for (i = 0; i < ndims; i++) {
+            start[i] = 0;
+            count[i] = dims[i];
+        }
+        start[1] = offset;
+        count[1] = len;
+        return (len > 0) ? 1 : 0;
+    }
+
+    /* block[k] is the number of grid points in one step along the
+       k-th grid dimension of the dataset (k = 1 for z). */
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    block[npd] = 1;
+    for (k = npd - 1; k > 0; k--) {
+        block[k] = block[k + 1] * dims[k + 1];
+    }
+
+    nboxes = 0;
+    end = offset + len;
+    while (offset < end) {
+        /* Use the coarsest step that offset is aligned on and that
+           fits in the remaining range. */
+        k = npd;
+        while (k > 1 && offset % block[k - 1] == 0 && offset + block[k - 1] <= end) {
+            k--;
+        }
+        n = (end - offset) / block[k];
+        if (k > 1) {
+            limit = (block[k - 1] - offset % block[k - 1]) / block[k];
+            n = (n < limit) ? n : limit;
+        }
+        _get_point_coord(scalarfield, coord, 0, offset, 0);
+        for (i = 0; i < ndims; i++) {
+            start[nboxes * ndims + i] = coord[i];
+            count[nboxes * ndims + i] =
+                (i == 0 || i > k) ? dims[i] : 1;
+        }
+        count[nboxes * ndims + k] = n;
+        nboxes += 1;
+        offset += n * block[k];
+    }
+    return nboxes;
+}
+
+static hid_t _create_complex_type(hid_t base_type_id)
+{
+    hid_t type_id;
+    size_t size;
+
+    size = H5Tget_size(base_type_id);
+    if ((type_id = H5Tcreate(H5T_COMPOUND, 2 * size)) < 0) {
+        return type_id;
+    }
+    if (H5Tinsert(type_id, "r", 0, base_type_id) < 0 ||
+        H5Tinsert(type_id, "i", size, base_type_id) < 0) {
+        H5Tclose(type_id);
+        return -1;
+    }
+    return type_id;
+}
+
+/* Both functions return a new type that should be closed by the caller. */
+static hid_t _create_disk_type(const escdf_grid_scalarfield_t *scalarfield)
+{
+    hid_t base_type_id;
+
+    if (scalarfield->storage_precision.is_set &&
+        scalarfield->storage_precision.value == ESCDF_PRECISION_SINGLE) {
+        base_type_id = H5T_IEEE_F32LE;
+    } else {
+        base_type_id = H5T_IEEE_F64LE;
+    }
+    if (_use_complex_type(scalarfield)) {
+        return _create_complex_type(base_type_id);
+    }
+    return H5Tcopy(base_type_id);
+}
+
+static hid_t _create_mem_type(const escdf_grid_scalarfield_t *scalarfield,
+                              hid_t base_type_id)
+{
+    if (_use_complex_type(scalarfield)) {
+        return _create_complex_type(base_type_id);
+    }
+    return H5Tcopy(base_type_id);
+}
+
+/* The coarsened levels of values_on_grid are stored in
+   values_on_grid_level_<l>, always with the grid layout. Level l has
+   ceil(n / 2^l) grid points along each direction. */
+#define MAX_NUMBER_OF_LEVELS 16
+
+static void _get_level_name(unsigned int level, char *name)
+{
+    sprintf(name, "values_on_grid_level_%u", level);
+}
+
+static void _get_level_grid_points(const escdf_grid_scalarfield_t *scalarfield,
+                                   unsigned int level, hsize_t *n)
+{
+    unsigned int i, l;
+
+    for (i = 0; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+        n[i] = scalarfield->number_of_grid_points[i];
+        for (l = 0; l < level; l++) {
+            n[i] = (n[i] + 1) / 2;
+        }
+    }
+}
+
+static unsigned int _get_level_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                    unsigned int level, size_t *dims)
+{
+    hsize_t n[3];
+    unsigned int i, ndims, npd;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    _get_level_grid_points(scalarfield, level, n);
+    ndims = 0;
+    dims[ndims++] = scalarfield->number_of_components.value;
+    for (i = npd; i > 0; i--) {
+        dims[ndims++] = n[i - 1];
+    }
+    if (!_use_complex_type(scalarfield)) {
+        dims[ndims++] = scalarfield->real_or_complex.value;
+    }
+    return ndims;
+}
+
+/* Average blocks of 2x2x2 grid points of fine into coarse. Both
+   arrays are [number_of_components, nz, ny, nx, real_or_complex]. On
+   odd sizes, the last block only averages the available points. */
+static void _coarsen(const escdf_grid_scalarfield_t *scalarfield,
+                     const double *fine, const hsize_t *nfine,
+                     double *coarse, const hsize_t *ncoarse)
+{
+    hsize_t nf[3], nc[3], x, y, z, dx, dy, dz, ifine, icoarse;
+    unsigned int i, c, v, nvalues, npd, nsum;
+    double sum;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    nvalues = scalarfield->real_or_complex.value;
+    for (i = 0; i < 3; i++) {
+        nf[i] = (i < npd) ? nfine[i] : 1;
+        nc[i] = (i < npd) ? ncoarse[i] : 1;
+    }
+    icoarse = 0;
+    for (c = 0; c < scalarfield->number_of_components.value; c++) {
+        for (z = 0; z < nc[2]; z++) {
+            for (y = 0; y < nc[1]; y++) {
+                for (x = 0; x < nc[0]; x++) {
+                    for (v = 0; v < nvalues; v++) {
+                        sum = 0.;
+                        nsum = 0;
+                        for (dz = 2 * z; dz < 2 * z + 2 && dz < nf[2]; dz++) {
+                            for (dy = 2 * y; dy < 2 * y + 2 && dy < nf[1]; dy++) {
+                                for (dx = 2 * x; dx < 2 * x + 2 && dx < nf[0]; dx++) {
+                                    ifine = (((c * nf[2] + dz) * nf[1] + dy) * nf[0] + dx) * nvalues + v;
+                                    sum += fine[ifine];
+                                    nsum += 1;
+                                }
+                            }
+                        }
+                        coarse[icoarse++] = sum / nsum;
+                    }
+                }
+            }
+        }
+    }
+}
+
 escdf_errno_t escdf_grid_scalarfield_read_metadata(escdf_grid_scalarfield_t *scalarfield,
                                                    escdf_handle_t *file_id)
 {
@@ -88,10 +500,16 @@ escdf_errno_t escdf_grid_scalarfield_read_metadata(escdf_grid_scalarfield_t *sca
     unsigned int rgGrid[2] = {1, 1024 * 1024};
     unsigned int rgComp[2] = {1, 4};
     unsigned int rgCplx[2] = {1, 2};
-    hsize_t oneDims[1];
-    hsize_t lattDims[2];
-    hsize_t valDims[3];
-    hid_t loc_id;
+    size_t oneDims[1];
+    size_t lattDims[2];
+    size_t valDims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t chunk[MAX_VALUES_ON_GRID_NDIMS];
+    hid_t loc_id, dtset_id, type_id, space_id, dcpl_id;
+    size_t type_size, cd_nelmts;
+    unsigned int ndims, npd, filter_flags, cd_value;
+    int nfilters;
+    bool ordered;
+    char name[32];
     
     FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
 
@@ -143,27 +561,116 @@ escdf_errno_t escdf_grid_scalarfield_read_metadata(escdf_grid_scalarfield_t *sca
         return err;
     }
 
-    if ((err = utils_hdf5_read_bool_old(loc_id, "use_default_ordering",
-                                    &scalarfield->use_default_ordering))
-        != ESCDF_SUCCESS) {
+    if ((err = utils_hdf5_read_attr_bool(loc_id, "use_default_ordering", NULL, 0,
+                                         &ordered)) != ESCDF_SUCCESS) {
         H5Gclose(loc_id);
         return err;
     }
+    scalarfield->use_default_ordering = _bool_set(ordered);
 
-    valDims[0] = scalarfield->number_of_components.value;
-    valDims[1] = scalarfield->number_of_grid_points[0];
-    for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
-        valDims[1] *= scalarfield->number_of_grid_points[i];
+    /* The storage precision, the complex storage and the layout are
+       given by the dataset itself. */
+    if ((dtset_id = H5Dopen(loc_id, "values_on_grid", H5P_DEFAULT)) < 0) {
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(dtset_id);
+    }
+    if ((type_id = H5Dget_type(dtset_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
     }
-    valDims[2] = scalarfield->real_or_complex.value;
-    if ((err = utils_hdf5_check_dataset(loc_id, "values_on_grid", valDims, 3, NULL)) != ESCDF_SUCCESS) {
+    type_size = H5Tget_size(type_id);
+    if (H5Tget_class(type_id) == H5T_COMPOUND) {
+        scalarfield->use_complex_type = _bool_set(true);
+        type_size /= 2;
+    }
+    scalarfield->storage_precision =
+        _uint_set((type_size < sizeof(double)) ?
+                  ESCDF_PRECISION_SINGLE : ESCDF_PRECISION_DOUBLE);
+    H5Tclose(type_id);
+    if (scalarfield->use_complex_type.value &&
+        scalarfield->real_or_complex.value != ESCDF_COMPLEX) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(ESCDF_EFILE_CORRUPT);
+    }
+    if ((space_id = H5Dget_space(dtset_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(space_id);
+    }
+    ndims = H5Sget_simple_extent_ndims(space_id);
+    H5Sclose(space_id);
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    if (npd > 1 && ndims == _get_values_on_grid_dims(scalarfield, valDims) + npd - 1) {
+        scalarfield->use_grid_layout = _bool_set(true);
+        free(scalarfield->grid_chunk_dims);
+        scalarfield->grid_chunk_dims = NULL;
+        if ((dcpl_id = H5Dget_create_plist(dtset_id)) >= 0) {
+            if (H5Pget_layout(dcpl_id) == H5D_CHUNKED &&
+                H5Pget_chunk(dcpl_id, MAX_VALUES_ON_GRID_NDIMS, chunk) == (int)ndims) {
+                scalarfield->grid_chunk_dims = malloc(sizeof(unsigned int) * npd);
+                for (i = 0; i < npd; i++) {
+                    scalarfield->grid_chunk_dims[i] = chunk[npd - i];
+                }
+            }
+            H5Pclose(dcpl_id);
+        }
+    }
+    scalarfield->compression_level = _uint_set(0);
+    if ((dcpl_id = H5Dget_create_plist(dtset_id)) >= 0) {
+        nfilters = H5Pget_nfilters(dcpl_id);
+        for (i = 0; i < (unsigned int)((nfilters > 0) ? nfilters : 0); i++) {
+            cd_nelmts = 1;
+            if (H5Pget_filter2(dcpl_id, i, &filter_flags, &cd_nelmts, &cd_value,
+                               0, NULL, NULL) == H5Z_FILTER_DEFLATE && cd_nelmts > 0) {
+                scalarfield->compression_level = _uint_set(cd_value);
+            }
+        }
+        H5Pclose(dcpl_id);
+    }
+    H5Dclose(dtset_id);
+
+    ndims = _get_values_on_grid_dims(scalarfield, valDims);
+    if ((err = utils_hdf5_check_dataset(loc_id, "values_on_grid", valDims,
+                                        ndims, NULL)) != ESCDF_SUCCESS) {
         H5Gclose(loc_id);
         return err;
     }
     scalarfield->values_on_grid_is_present = true;
 
+    /* Coarsened levels, if any. */
+    for (i = 1; i <= MAX_NUMBER_OF_LEVELS; i++) {
+        _get_level_name(i, name);
+        if (!utils_hdf5_check_present(loc_id, name)) {
+            break;
+        }
+    }
+    scalarfield->number_of_levels = _uint_set(i - 1);
+
+    scalarfield->use_chunk_statistics =
+        _bool_set(utils_hdf5_check_present(loc_id, "values_on_grid_chunk_minimum"));
+
+    scalarfield->use_time_series =
+        _bool_set(utils_hdf5_check_present(loc_id, "values_on_grid_frames"));
+    scalarfield->keyframe_interval = _uint_set(0);
+    if (scalarfield->use_time_series.value &&
+        utils_hdf5_open_dataset(loc_id, "values_on_grid_frames", &dtset_id) == ESCDF_SUCCESS) {
+        if (utils_hdf5_check_present_attr(dtset_id, "keyframe_interval")) {
+            err = utils_hdf5_read_attr(dtset_id, "keyframe_interval", H5T_NATIVE_UINT,
+                                       NULL, 0, &scalarfield->keyframe_interval.value);
+            if (err != ESCDF_SUCCESS) {
+                H5Dclose(dtset_id);
+                H5Gclose(loc_id);
+                return err;
+            }
+        }
+        H5Dclose(dtset_id);
+    }
+
     if (!scalarfield->use_default_ordering.value) {
-        if ((err = utils_hdf5_check_dataset(loc_id, "grid_ordering", valDims + 1, 1, NULL)) != ESCDF_SUCCESS) {
+        valDims[0] = _get_number_of_points(scalarfield);
+        if ((err = utils_hdf5_check_dataset(loc_id, "grid_ordering", valDims, 1, NULL)) != ESCDF_SUCCESS) {
             H5Gclose(loc_id);
             return err;
         }
@@ -174,13 +681,102 @@ escdf_errno_t escdf_grid_scalarfield_read_metadata(escdf_grid_scalarfield_t *sca
     return ESCDF_SUCCESS;
 }
 
+/* The snapshots of a time series are stored in values_on_grid_frames,
+   shaped [number of frames, values_on_grid dims], with an unlimited
+   leading dimension. Chunks are those of values_on_grid with a
+   leading frame dimension of one, or one component of one frame
+   without the grid layout, so that appending a frame never touches
+   the previous ones. With a keyframe interval n > 1, only one frame
+   every n is stored as is; the others are stored as the bitwise XOR
+   of their disk representation with their keyframe, which is
+   lossless and leaves mostly zero bytes for slowly varying fields,
+   hence the shuffle and deflate filters. Appending or reading a
+   delta thus reads one extra frame, the keyframe. */
+#define KEYFRAME_DEFLATE_LEVEL 6
+
+static unsigned int _get_keyframe_interval(const escdf_grid_scalarfield_t *scalarfield)
+{
+    return (scalarfield->keyframe_interval.is_set) ? scalarfield->keyframe_interval.value : 0;
+}
+
+static escdf_errno_t _create_values_on_grid_frames(const escdf_grid_scalarfield_t *scalarfield,
+                                                   hid_t loc_id)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, dtspace_id, dcpl_id, type_id;
+    unsigned int interval;
+    size_t vdims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t dims[MAX_VALUES_ON_GRID_NDIMS + 1], maxdims[MAX_VALUES_ON_GRID_NDIMS + 1];
+    hsize_t chunk[MAX_VALUES_ON_GRID_NDIMS + 1], gchunk[3];
+    unsigned int i, ndims, npd;
+
+    ndims = _get_values_on_grid_dims(scalarfield, vdims);
+    dims[0] = 0;
+    maxdims[0] = H5S_UNLIMITED;
+    chunk[0] = 1;
+    for (i = 1; i <= ndims; i++) {
+        dims[i] = vdims[i - 1];
+        maxdims[i] = dims[i];
+        chunk[i] = dims[i];
+    }
+    chunk[1] = 1;
+    if (_use_grid_layout(scalarfield)) {
+        npd = scalarfield->cell.number_of_physical_dimensions.value;
+        _get_grid_chunk_dims(scalarfield, gchunk);
+        for (i = 0; i < npd; i++) {
+            chunk[2 + i] = gchunk[npd - 1 - i];
+        }
+    }
+
+    if ((dtspace_id = H5Screate_simple(ndims + 1, dims, maxdims)) < 0) {
+        RETURN_WITH_ERROR(dtspace_id);
+    }
+    if ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0) {
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(dcpl_id);
+    }
+    if (H5Pset_chunk(dcpl_id, ndims + 1, chunk) < 0) {
+        H5Pclose(dcpl_id);
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    interval = _get_keyframe_interval(scalarfield);
+    if (interval > 1 && (H5Pset_shuffle(dcpl_id) < 0 ||
+                         H5Pset_deflate(dcpl_id, KEYFRAME_DEFLATE_LEVEL) < 0)) {
+        H5Pclose(dcpl_id);
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    if ((type_id = _create_disk_type(scalarfield)) < 0) {
+        H5Pclose(dcpl_id);
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    dtset_id = H5Dcreate(loc_id, "values_on_grid_frames", type_id, dtspace_id,
+                         H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+    H5Tclose(type_id);
+    H5Pclose(dcpl_id);
+    H5Sclose(dtspace_id);
+    FULFILL_OR_RETURN(dtset_id >= 0, dtset_id);
+    err = ESCDF_SUCCESS;
+    if (interval > 1) {
+        err = utils_hdf5_write_attr(dtset_id, "keyframe_interval", H5T_STD_U32LE,
+                                    NULL, 0, H5T_NATIVE_UINT, &interval);
+    }
+    H5Dclose(dtset_id);
+
+    return err;
+}
+
 escdf_errno_t escdf_grid_scalarfield_write_metadata(const escdf_grid_scalarfield_t *scalarfield, escdf_handle_t *loc_id)
 {
-    hid_t gid;
+    hid_t gid, type_id, dcpl_id;
     escdf_errno_t err;
-    hsize_t dims[3];
-    unsigned int i;
-    int value;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t chunk[MAX_VALUES_ON_GRID_NDIMS], gchunk[3], block, nsplit;
+    size_t point_size;
+    unsigned int i, ndims, npd;
+    char name[32];
     
     FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
 
@@ -191,6 +787,10 @@ escdf_errno_t escdf_grid_scalarfield_write_metadata(const escdf_grid_scalarfield
     FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    /* The grid layout is only meaningful with the default ordering. */
+    FULFILL_OR_RETURN(!_use_grid_layout(scalarfield) ||
+                      !scalarfield->use_default_ordering.is_set ||
+                      scalarfield->use_default_ordering.value, ESCDF_EVALUE);
 
     gid = H5Gcreate(loc_id->group_id, scalarfield->path, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
     FULFILL_OR_RETURN(gid >= 0, gid);
@@ -241,29 +841,118 @@ escdf_errno_t escdf_grid_scalarfield_write_metadata(const escdf_grid_scalarfield
         return err;
     }
 
-    /*
-    if ((err = utils_hdf5_write_bool_old
-            (gid, "use_default_ordering", scalarfield->use_default_ordering.value)) != ESCDF_SUCCESS) {
+    if ((err = utils_hdf5_write_attr_bool
+         (gid, "use_default_ordering", NULL, 0,
+          &scalarfield->use_default_ordering.value)) != ESCDF_SUCCESS) {
         H5Gclose(gid);
         return err;
     }
-    */
 
     /* Only create shapes for data. */
-    dims[0] = scalarfield->number_of_components.value;
-    dims[1] = scalarfield->number_of_grid_points[0];
-    for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
-        dims[1] *= scalarfield->number_of_grid_points[i];
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    if ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0) {
+        H5Gclose(gid);
+        RETURN_WITH_ERROR(dcpl_id);
+    }
+    if (_use_grid_layout(scalarfield)) {
+        /* One chunk holds a 3D block of one component. */
+        npd = scalarfield->cell.number_of_physical_dimensions.value;
+        _get_grid_chunk_dims(scalarfield, gchunk);
+        chunk[0] = 1;
+        for (i = 0; i < npd; i++) {
+            chunk[1 + i] = gchunk[npd - 1 - i];
+        }
+        if (ndims > npd + 1) {
+            chunk[npd + 1] = dims[npd + 1];
+        }
+        if (H5Pset_chunk(dcpl_id, ndims, chunk) < 0) {
+            H5Pclose(dcpl_id);
+            H5Gclose(gid);
+            RETURN_WITH_ERROR(ESCDF_ERROR);
+        }
+    }
+    if ((type_id = _create_disk_type(scalarfield)) < 0) {
+        H5Pclose(dcpl_id);
+        H5Gclose(gid);
+        RETURN_WITH_ERROR(type_id);
+    }
+    if (_get_compression_level(scalarfield) > 0) {
+        if (!_use_grid_layout(scalarfield)) {
+            /* The size of a point on disk, whatever the storage
+               precision and the complex type. */
+            point_size = H5Tget_size(type_id) * ((ndims > 2) ? dims[2] : 1);
+            /* The slices of sliced writes are not known yet, chunks
+               follow the block decomposition of the redistributed
+               writes. */
+            block = _get_block_size(dims[1], loc_id->mpi_size);
+            nsplit = (block * point_size + MAX_COMPRESSED_CHUNK_SIZE - 1) / MAX_COMPRESSED_CHUNK_SIZE;
+            chunk[0] = 1;
+            chunk[1] = (block + nsplit - 1) / nsplit;
+            if (ndims > 2) {
+                chunk[2] = dims[2];
+            }
+            if (H5Pset_chunk(dcpl_id, ndims, chunk) < 0) {
+                H5Tclose(type_id);
+                H5Pclose(dcpl_id);
+                H5Gclose(gid);
+                RETURN_WITH_ERROR(ESCDF_ERROR);
+            }
+        }
+        /* Parallel writes of filtered datasets need their chunks to be
+           allocated at creation. */
+        if (H5Pset_shuffle(dcpl_id) < 0 ||
+            H5Pset_deflate(dcpl_id, _get_compression_level(scalarfield)) < 0 ||
+            H5Pset_alloc_time(dcpl_id, H5D_ALLOC_TIME_EARLY) < 0) {
+            H5Tclose(type_id);
+            H5Pclose(dcpl_id);
+            H5Gclose(gid);
+            RETURN_WITH_ERROR(ESCDF_ERROR);
+        }
     }
-    dims[2] = scalarfield->real_or_complex.value;
-    if ((err = utils_hdf5_create_dataset
-         (gid, "values_on_grid", H5T_IEEE_F64LE, dims, 3, NULL)) != ESCDF_SUCCESS) {
+    err = utils_hdf5_create_dataset_dcpl(gid, "values_on_grid", type_id, dims,
+                                         ndims, dcpl_id, NULL);
+    H5Tclose(type_id);
+    H5Pclose(dcpl_id);
+    if (err != ESCDF_SUCCESS) {
         H5Gclose(gid);
         return err;
     }
+    if (scalarfield->number_of_levels.is_set) {
+        if ((type_id = _create_disk_type(scalarfield)) < 0) {
+            H5Gclose(gid);
+            RETURN_WITH_ERROR(type_id);
+        }
+        for (i = 1; i <= scalarfield->number_of_levels.value; i++) {
+            _get_level_name(i, name);
+            ndims = _get_level_dims(scalarfield, i, dims);
+            if ((err = utils_hdf5_create_dataset(gid, name, type_id, dims, ndims, NULL)) != ESCDF_SUCCESS) {
+                H5Tclose(type_id);
+                H5Gclose(gid);
+                return err;
+            }
+        }
+        H5Tclose(type_id);
+    }
+    if (scalarfield->use_chunk_statistics.is_set && scalarfield->use_chunk_statistics.value) {
+        ndims = _get_chunk_statistics_dims(scalarfield, dims);
+        if ((err = utils_hdf5_create_dataset(gid, "values_on_grid_chunk_minimum", H5T_IEEE_F64LE,
+                                             dims, ndims, NULL)) != ESCDF_SUCCESS ||
+            (err = utils_hdf5_create_dataset(gid, "values_on_grid_chunk_maximum", H5T_IEEE_F64LE,
+                                             dims, ndims, NULL)) != ESCDF_SUCCESS) {
+            H5Gclose(gid);
+            return err;
+        }
+    }
+    if (scalarfield->use_time_series.is_set && scalarfield->use_time_series.value) {
+        if ((err = _create_values_on_grid_frames(scalarfield, gid)) != ESCDF_SUCCESS) {
+            H5Gclose(gid);
+            return err;
+        }
+    }
     if (!scalarfield->use_default_ordering.value) {
+        dims[0] = _get_number_of_points(scalarfield);
         if ((err = utils_hdf5_create_dataset
-             (gid, "grid_ordering", H5T_STD_U32LE, dims + 1, 1, NULL)) != ESCDF_SUCCESS) {
+             (gid, "grid_ordering", H5T_STD_U32LE, dims, 1, NULL)) != ESCDF_SUCCESS) {
             H5Gclose(gid);
             return err;
         }
@@ -360,42 +1049,130 @@ bool escdf_grid_scalarfield_get_use_default_ordering(const escdf_grid_scalarfiel
     
     return scalarfield->use_default_ordering.value;
 }
-
-
-/************/
-/* Setters. */
-/************/
-escdf_errno_t escdf_grid_scalarfield_set_number_of_physical_dimensions(escdf_grid_scalarfield_t *scalarfield,
-                                                                       const unsigned int number_of_physical_dimensions)
+escdf_storage_precision escdf_grid_scalarfield_get_storage_precision(const escdf_grid_scalarfield_t *scalarfield)
 {
-    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
-    FULFILL_OR_RETURN(number_of_physical_dimensions > 0 &&
-                      number_of_physical_dimensions < 4, ESCDF_ERANGE);
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, ESCDF_PRECISION_DOUBLE);
 
-    scalarfield->cell.number_of_physical_dimensions =
-        _uint_set(number_of_physical_dimensions);
+    /* Double precision is the default when not set. */
+    if (!scalarfield->storage_precision.is_set) {
+        return ESCDF_PRECISION_DOUBLE;
+    }
+    return (escdf_storage_precision)scalarfield->storage_precision.value;
+}
+bool escdf_grid_scalarfield_get_use_complex_type(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, false);
 
-    return ESCDF_SUCCESS;
+    return scalarfield->use_complex_type.is_set && scalarfield->use_complex_type.value;
 }
+unsigned int escdf_grid_scalarfield_get_number_of_levels(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, 0);
 
-escdf_errno_t escdf_grid_scalarfield_set_dimension_types(escdf_grid_scalarfield_t *scalarfield,
-                                                         const escdf_direction_type *dimension_types,
-                                                         const size_t len)
+    return (scalarfield->number_of_levels.is_set) ? scalarfield->number_of_levels.value : 0;
+}
+escdf_errno_t escdf_grid_scalarfield_get_level_number_of_grid_points(const escdf_grid_scalarfield_t *scalarfield,
+                                                                     unsigned int level,
+                                                                     unsigned int *number_of_grid_points,
+                                                                     const size_t len)
 {
+    hsize_t n[3];
     unsigned int i;
-    
+
     FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
-    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_ESIZE_MISSING);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(len == scalarfield->cell.number_of_physical_dimensions.value, ESCDF_ESIZE);
-    for (i = 0; i < len; i++) {
-        FULFILL_OR_RETURN(dimension_types[i] >= ESCDF_DIRECTION_FREE &&
-                          dimension_types[i] < ESCDF_N_DIRECTION_TYPE, ESCDF_ERANGE);
-    }
+    FULFILL_OR_RETURN(level <= escdf_grid_scalarfield_get_number_of_levels(scalarfield), ESCDF_ERANGE);
 
-    free(scalarfield->cell.dimension_types);
-    scalarfield->cell.dimension_types = malloc(sizeof(int) * len);
+    _get_level_grid_points(scalarfield, level, n);
     for (i = 0; i < len; i++) {
-        scalarfield->cell.dimension_types[i] = (int)dimension_types[i];
+        number_of_grid_points[i] = n[i];
+    }
+    return ESCDF_SUCCESS;
+}
+bool escdf_grid_scalarfield_get_use_chunk_statistics(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, false);
+
+    return scalarfield->use_chunk_statistics.is_set && scalarfield->use_chunk_statistics.value;
+}
+bool escdf_grid_scalarfield_get_use_time_series(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, false);
+
+    return scalarfield->use_time_series.is_set && scalarfield->use_time_series.value;
+}
+unsigned int escdf_grid_scalarfield_get_keyframe_interval(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, 0);
+
+    return _get_keyframe_interval(scalarfield);
+}
+unsigned int escdf_grid_scalarfield_get_compression_level(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, 0);
+
+    return _get_compression_level(scalarfield);
+}
+bool escdf_grid_scalarfield_get_use_grid_layout(const escdf_grid_scalarfield_t *scalarfield)
+{
+    FULFILL_OR_RETURN_VAL(scalarfield, ESCDF_EOBJECT, false);
+
+    return _use_grid_layout(scalarfield);
+}
+escdf_errno_t escdf_grid_scalarfield_get_grid_chunk_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                                         unsigned int *grid_chunk_dims,
+                                                         const size_t len)
+{
+    hsize_t chunk[3];
+    unsigned int i;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(len == scalarfield->cell.number_of_physical_dimensions.value, ESCDF_ESIZE);
+
+    _get_grid_chunk_dims(scalarfield, chunk);
+    for (i = 0; i < len; i++) {
+        grid_chunk_dims[i] = chunk[i];
+    }
+    return ESCDF_SUCCESS;
+}
+
+
+/************/
+/* Setters. */
+/************/
+escdf_errno_t escdf_grid_scalarfield_set_number_of_physical_dimensions(escdf_grid_scalarfield_t *scalarfield,
+                                                                       const unsigned int number_of_physical_dimensions)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(number_of_physical_dimensions > 0 &&
+                      number_of_physical_dimensions < 4, ESCDF_ERANGE);
+
+    scalarfield->cell.number_of_physical_dimensions =
+        _uint_set(number_of_physical_dimensions);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_dimension_types(escdf_grid_scalarfield_t *scalarfield,
+                                                         const escdf_direction_type *dimension_types,
+                                                         const size_t len)
+{
+    unsigned int i;
+    
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_ESIZE_MISSING);
+    FULFILL_OR_RETURN(len == scalarfield->cell.number_of_physical_dimensions.value, ESCDF_ESIZE);
+    for (i = 0; i < len; i++) {
+        FULFILL_OR_RETURN(dimension_types[i] >= ESCDF_DIRECTION_FREE &&
+                          dimension_types[i] < ESCDF_N_DIRECTION_TYPE, ESCDF_ERANGE);
+    }
+
+    free(scalarfield->cell.dimension_types);
+    scalarfield->cell.dimension_types = malloc(sizeof(int) * len);
+    for (i = 0; i < len; i++) {
+        scalarfield->cell.dimension_types[i] = (int)dimension_types[i];
     }
 
     return ESCDF_SUCCESS;
@@ -475,71 +1252,181 @@ escdf_errno_t escdf_grid_scalarfield_set_use_default_ordering(escdf_grid_scalarf
     return ESCDF_SUCCESS;
 }
 
+escdf_errno_t escdf_grid_scalarfield_set_storage_precision(escdf_grid_scalarfield_t *scalarfield,
+                                                           const escdf_storage_precision storage_precision)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(storage_precision == ESCDF_PRECISION_DOUBLE ||
+                      storage_precision == ESCDF_PRECISION_SINGLE, ESCDF_ERANGE);
+
+    scalarfield->storage_precision = _uint_set((unsigned int)storage_precision);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_use_complex_type(escdf_grid_scalarfield_t *scalarfield,
+                                                          const bool use_complex_type)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+
+    scalarfield->use_complex_type = _bool_set(use_complex_type);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_use_grid_layout(escdf_grid_scalarfield_t *scalarfield,
+                                                         const bool use_grid_layout)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+
+    scalarfield->use_grid_layout = _bool_set(use_grid_layout);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_use_chunk_statistics(escdf_grid_scalarfield_t *scalarfield,
+                                                              const bool use_chunk_statistics)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+
+    scalarfield->use_chunk_statistics = _bool_set(use_chunk_statistics);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_use_time_series(escdf_grid_scalarfield_t *scalarfield,
+                                                         const bool use_time_series)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+
+    scalarfield->use_time_series = _bool_set(use_time_series);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_keyframe_interval(escdf_grid_scalarfield_t *scalarfield,
+                                                           const unsigned int keyframe_interval)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+
+    scalarfield->keyframe_interval = _uint_set(keyframe_interval);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_compression_level(escdf_grid_scalarfield_t *scalarfield,
+                                                           const unsigned int compression_level)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(compression_level <= 9, ESCDF_ERANGE);
+
+    scalarfield->compression_level = _uint_set(compression_level);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_number_of_levels(escdf_grid_scalarfield_t *scalarfield,
+                                                         const unsigned int number_of_levels)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(number_of_levels <= MAX_NUMBER_OF_LEVELS, ESCDF_ERANGE);
+
+    scalarfield->number_of_levels = _uint_set(number_of_levels);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_set_grid_chunk_dims(escdf_grid_scalarfield_t *scalarfield,
+                                                         const unsigned int *grid_chunk_dims,
+                                                         const size_t len)
+{
+    unsigned int i;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_ESIZE_MISSING);
+    FULFILL_OR_RETURN(len == scalarfield->cell.number_of_physical_dimensions.value, ESCDF_ESIZE);
+    for (i = 0; i < len; i++) {
+        FULFILL_OR_RETURN(grid_chunk_dims[i] > 0, ESCDF_ERANGE);
+    }
+
+    free(scalarfield->grid_chunk_dims);
+    scalarfield->grid_chunk_dims = malloc(sizeof(unsigned int) * len);
+    memcpy(scalarfield->grid_chunk_dims, grid_chunk_dims, sizeof(unsigned int) * len);
+
+    return ESCDF_SUCCESS;
+}
+
 /*******************/
 /* Data accessors. */
 /*******************/
+/* Compute the offset of the local slice in the global zyx ordering
+   as the exclusive prefix sum of the slice lengths, and check that
+   the slices cover the grid exactly. This is collective. */
 static escdf_errno_t _get_proc_grid_offset(hsize_t *my_offset,
                                            escdf_handle_t *file_id,
                                            unsigned int number_of_physical_dimensions,
                                            unsigned int *number_of_grid_points,
                                            hsize_t my_len)
 {
-    unsigned long long int *proclens;
-    unsigned long long int len_;
-    hsize_t nValues, nGridPoints;
-    int i;
+    unsigned long long int len_, offset_, total_;
+    hsize_t nGridPoints;
+    unsigned int i;
 
-    proclens = malloc(sizeof(unsigned long long int) * file_id->mpi_size);
     len_ = (unsigned long long int)my_len;
-    if (file_id->mpi_size == 1) {
-        proclens[0] = len_;
-    }
+    offset_ = 0;
+    total_ = len_;
 #ifdef HAVE_MPI
-    else {
-        MPI_Allgather(&len_, 1, MPI_UNSIGNED_LONG_LONG,
-                      proclens, 1, MPI_UNSIGNED_LONG_LONG, file_id->comm);
+    if (file_id->mpi_size > 1) {
+        MPI_Exscan(&len_, &offset_, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, file_id->comm);
+        /* The receive buffer of MPI_Exscan is undefined on rank 0. */
+        if (file_id->mpi_rank == 0) {
+            offset_ = 0;
+        }
+        MPI_Allreduce(&len_, &total_, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, file_id->comm);
     }
+#else
+    (void)file_id;
 #endif
-
-    *my_offset = 0;
-    for (i = 0; i < file_id->mpi_rank; i++) {
-        *my_offset += proclens[i];
-    }
-
-    /* Check that sum(proclens) == product(number_of_grid_points). */
-    nValues = proclens[0];
-    for (i = 1; i < file_id->mpi_size; i++) {
-        nValues += proclens[i];
-    }
-    free(proclens);
+    *my_offset = (hsize_t)offset_;
 
     nGridPoints = number_of_grid_points[0];
     for (i = 1; i < number_of_physical_dimensions; i++) {
         nGridPoints *= number_of_grid_points[i];
     }
 
-    FULFILL_OR_RETURN(nValues == nGridPoints, ESCDF_ESIZE);
+    FULFILL_OR_RETURN((hsize_t)total_ == nGridPoints, ESCDF_ESIZE);
 
     return ESCDF_SUCCESS;
 }
 
+escdf_errno_t escdf_grid_scalarfield_get_slice_offset(const escdf_grid_scalarfield_t *scalarfield,
+                                                      escdf_handle_t *file_id,
+                                                      const hsize_t len,
+                                                      hsize_t *offset)
+{
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(file_id, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(offset, ESCDF_EVALUE);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+
+    return _get_proc_grid_offset(offset, file_id,
+                                 scalarfield->cell.number_of_physical_dimensions.value,
+                                 scalarfield->number_of_grid_points, len);
+}
+
 static escdf_errno_t _get_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
                                          const hid_t loc_id, hid_t *dtset_id)
 {
-    hsize_t bounds[3];
-    unsigned int i;
+    size_t bounds[MAX_VALUES_ON_GRID_NDIMS];
+    unsigned int ndims;
 
     /* Check that variable on disk is consistent with metadata in scalarfield. */
     /* Create the global distribution bounds. */
-    bounds[0] = scalarfield->number_of_components.value;
-    bounds[1] = scalarfield->number_of_grid_points[0];
-    for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
-        bounds[1] *= scalarfield->number_of_grid_points[i];
-    }
-    bounds[2] = scalarfield->real_or_complex.value;
+    ndims = _get_values_on_grid_dims(scalarfield, bounds);
     /* Get the dataset for this variable and check its dimensions. */
-    FULFILL_OR_RETURN(utils_hdf5_check_dataset(loc_id, "values_on_grid",
-                                               bounds, 3, dtset_id) == ESCDF_SUCCESS,
+    FULFILL_OR_RETURN(utils_hdf5_check_dataset(loc_id, "values_on_grid", bounds,
+                                               ndims, dtset_id) == ESCDF_SUCCESS,
                       ESCDF_ERROR);
     return ESCDF_SUCCESS;
 }
@@ -547,7 +1434,7 @@ static escdf_errno_t _get_values_on_grid(const escdf_grid_scalarfield_t *scalarf
 static escdf_errno_t _get_g2d(const escdf_grid_scalarfield_t *scalarfield,
                               hid_t loc_id, unsigned int **g2d)
 {
-    hsize_t len;
+    size_t len;
     unsigned int i;
     hid_t dtset_id;
     escdf_errno_t err;
@@ -591,19 +1478,22 @@ static escdf_errno_t _get_g2d(const escdf_grid_scalarfield_t *scalarfield,
 
 static escdf_errno_t _read_at(const escdf_grid_scalarfield_t *scalarfield,
                               escdf_handle_t *file_id, hid_t loc_id,
-                              double *buf,
+                              void *buf, hid_t mem_type_id,
                               const unsigned int *indirect,
                               const hsize_t glen)
 {
     escdf_errno_t err;
-    hid_t dtset_id;
-    hsize_t *coord;
-    size_t num_elements;
-    unsigned int i, j;
+    hid_t dtset_id, elem_type_id;
+    size_t *coord;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    size_t num_elements, elem_size;
+    unsigned int i, j, k, ndims, nvalues;
 
     /* To limit the size of coord array, only MAX_BLOCK_SIZE grid
        points are read at once. Thus the memory footprint of this
-       function is MAX_BLOCK_SIZE * 16 bytes (times 2 if complex). */
+       function is MAX_BLOCK_SIZE * 8 bytes times the rank of
+       values_on_grid (times 2 if complex values are stored with a
+       trailing dimension). */
     size_t iblock, nblock, j0;
     size_t blocksize, offset;
 #define MAX_BLOCK_SIZE (1024 * 1024)
@@ -615,42 +1505,41 @@ static escdf_errno_t _read_at(const escdf_grid_scalarfield_t *scalarfield,
 
     /* We generate an element selection in the disk dataspace. To
        limit the size of the coord array, the various scalarfield
-       components are read separately. */
+       components are read separately. With the compound complex
+       type, there is one element per grid point. */
     num_elements = glen * scalarfield->real_or_complex.value;
+    nvalues = (_use_complex_type(scalarfield)) ? 1 : scalarfield->real_or_complex.value;
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
     
     nblock = glen / MAX_BLOCK_SIZE;
     if (nblock * MAX_BLOCK_SIZE < glen) {
         nblock += 1;
     }
 
-    coord = malloc(sizeof(hsize_t) * MAX_BLOCK_SIZE *
-                   scalarfield->real_or_complex.value * 3);
+    if ((elem_type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        RETURN_WITH_ERROR(elem_type_id);
+    }
+    elem_size = H5Tget_size(mem_type_id);
+
+    coord = malloc(sizeof(size_t) * MAX_BLOCK_SIZE * nvalues * ndims);
     for (i = 0; i < scalarfield->number_of_components.value; i++) {
         j0 = 0;
         for (iblock = 0; iblock < nblock; iblock++) {
             blocksize = (glen - j0 < MAX_BLOCK_SIZE) ? glen - j0 : MAX_BLOCK_SIZE;
-            if (scalarfield->real_or_complex.value == ESCDF_COMPLEX) {
-                for (j = 0; j < blocksize; j++) {
-                    coord[(j * 2 + 0) * 3 + 0] = i;
-                    coord[(j * 2 + 0) * 3 + 1] = indirect[j0 + j];
-                    coord[(j * 2 + 0) * 3 + 2] = 0;
-                    coord[(j * 2 + 1) * 3 + 0] = i;
-                    coord[(j * 2 + 1) * 3 + 1] = indirect[j0 + j];
-                    coord[(j * 2 + 1) * 3 + 2] = 1;
-                }
-            } else {
-                for (j = 0; j < blocksize; j++) {
-                    coord[j * 3 + 0] = i;
-                    coord[j * 3 + 1] = indirect[j0 + j];
-                    coord[j * 3 + 2] = 0;
+            offset = i * num_elements + j0 * scalarfield->real_or_complex.value;
+            for (j = 0; j < blocksize; j++) {
+                for (k = 0; k < nvalues; k++) {
+                    _get_point_coord(scalarfield, coord + (j * nvalues + k) * ndims,
+                                     i, indirect[j0 + j], k);
                 }
             }
-            offset = i * num_elements + j0 * scalarfield->real_or_complex.value;
             if ((err = utils_hdf5_read_dataset_at(dtset_id, file_id->transfer_mode,
-                                                  buf + offset,
-                                                  H5T_NATIVE_DOUBLE,
-                                                  blocksize * scalarfield->real_or_complex.value, coord)) != ESCDF_SUCCESS) {
+                                                  (char*)buf + offset * elem_size,
+                                                  elem_type_id,
+                                                  blocksize * nvalues, coord)) != ESCDF_SUCCESS) {
                 free(coord);
+                H5Tclose(elem_type_id);
                 H5Dclose(dtset_id);
                 return err;
             }
@@ -658,10 +1547,24 @@ static escdf_errno_t _read_at(const escdf_grid_scalarfield_t *scalarfield,
         }
     }
     free(coord);
+    H5Tclose(elem_type_id);
     H5Dclose(dtset_id);
     return ESCDF_SUCCESS;
 }
 
+static escdf_errno_t _write_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                           escdf_handle_t *file_id,
+                                           const void *buf, hid_t mem_type_id,
+                                           const unsigned int *tbl,
+                                           const hsize_t *start,
+                                           const hsize_t *count,
+                                           const hsize_t *stride,
+                                           const hsize_t *mem_dims,
+                                           unsigned int mem_ndims,
+                                           const hsize_t *mem_start,
+                                           const hsize_t *mem_count,
+                                           const hsize_t *mem_stride);
+
 escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_ordered(const escdf_grid_scalarfield_t *scalarfield,
                                                                   escdf_handle_t *file_id,
                                                                   const double *buf,
@@ -679,172 +1582,2258 @@ escdf_errno_t escdf_grid_scalarfield_write_values_on_grid(const escdf_grid_scala
                                                           const hsize_t *start,
                                                           const hsize_t *count,
                                                           const hsize_t *stride)
+{
+    return _write_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                 tbl, start, count, stride, NULL, 0, NULL, NULL, NULL);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                escdf_handle_t *file_id,
+                                                                const float *buf,
+                                                                const unsigned int *tbl,
+                                                                const hsize_t *start,
+                                                                const hsize_t *count,
+                                                                const hsize_t *stride)
+{
+    return _write_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                 tbl, start, count, stride, NULL, 0, NULL, NULL, NULL);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_mem(const escdf_grid_scalarfield_t *scalarfield,
+                                                              escdf_handle_t *file_id,
+                                                              const double *buf,
+                                                              const unsigned int *tbl,
+                                                              const hsize_t *start,
+                                                              const hsize_t *count,
+                                                              const hsize_t *stride,
+                                                              const hsize_t *mem_dims,
+                                                              unsigned int mem_ndims,
+                                                              const hsize_t *mem_start,
+                                                              const hsize_t *mem_count,
+                                                              const hsize_t *mem_stride)
+{
+    return _write_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                 tbl, start, count, stride,
+                                 mem_dims, mem_ndims, mem_start, mem_count, mem_stride);
+}
+static escdf_errno_t _write_grid_ordering(const escdf_grid_scalarfield_t *scalarfield,
+                                          escdf_handle_t *file_id, hid_t loc_id,
+                                          const unsigned int *tbl,
+                                          const hsize_t *start,
+                                          const hsize_t *count,
+                                          const hsize_t *stride)
 {
     escdf_errno_t err;
-    hid_t dtset_id, loc_id;
-    hsize_t len;
-    unsigned int i;
-
-    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
-    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
-    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
-    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
-    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
-    if (tbl != NULL) {
-        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
-                          !scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
-    } else {
-        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
-                          scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
-    }
-    
-    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
-        RETURN_WITH_ERROR(loc_id);
-    }
+    hid_t dtset_id;
+    size_t len, start_, count_, stride_;
 
-    /* Write buf in dataset "values_on_grid". */
-    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
-        H5Gclose(loc_id);
-        return err;
-    }
-    if ((err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode,
-                                        buf, H5T_NATIVE_DOUBLE,
-                                        start, count, stride)) != ESCDF_SUCCESS) {
-        H5Dclose(dtset_id);
-        H5Gclose(loc_id);
+    len = _get_number_of_points(scalarfield);
+    if ((err = utils_hdf5_check_dataset(loc_id, "grid_ordering",
+                                        &len, 1, &dtset_id)) != ESCDF_SUCCESS) {
         return err;
     }
+
+    /* Actual write action, the selection is one-dimensional. */
+    start_ = (start) ? start[0] : 0;
+    count_ = (count) ? count[0] : 0;
+    stride_ = (stride) ? stride[0] : 1;
+    err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode,
+                                   tbl, H5T_NATIVE_INT,
+                                   (start) ? &start_ : NULL,
+                                   (count) ? &count_ : NULL,
+                                   (stride) ? &stride_ : NULL);
     H5Dclose(dtset_id);
+    return err;
+}
 
-    /* Write the lookup table. */
-    if (tbl != NULL) {
-        len = scalarfield->number_of_grid_points[0];
-        for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
-            len *= scalarfield->number_of_grid_points[i];
-        }
+/* Compute and write all the coarsened levels from the full field,
+   given in the default ordering. */
+static escdf_errno_t _write_levels(const escdf_grid_scalarfield_t *scalarfield,
+                                   escdf_handle_t *file_id, hid_t loc_id,
+                                   const double *buf)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, type_id;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t nfine[3], ncoarse[3], len;
+    unsigned int i, level, ndims;
+    const double *fine;
+    double *coarse;
+    char name[32];
 
-        if ((err = utils_hdf5_check_dataset(loc_id, "grid_ordering",
-                                            &len, 1, &dtset_id)) != ESCDF_SUCCESS) {
-            H5Gclose(loc_id);
-            return err;
+    if ((type_id = _create_mem_type(scalarfield, H5T_NATIVE_DOUBLE)) < 0) {
+        RETURN_WITH_ERROR(type_id);
+    }
+    err = ESCDF_SUCCESS;
+    fine = buf;
+    for (level = 1; level <= scalarfield->number_of_levels.value; level++) {
+        _get_level_grid_points(scalarfield, level - 1, nfine);
+        _get_level_grid_points(scalarfield, level, ncoarse);
+        len = scalarfield->number_of_components.value * scalarfield->real_or_complex.value;
+        for (i = 0; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+            len *= ncoarse[i];
         }
+        coarse = malloc(sizeof(double) * len);
+        _coarsen(scalarfield, fine, nfine, coarse, ncoarse);
+        if (fine != buf) {
+            free((double*)fine);
+        }
+        fine = coarse;
 
-        /* Actual write action. */
-        if ((err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode,
-                                            tbl, H5T_NATIVE_INT,
-                                            (start) ? start + 1 : NULL,
-                                            (count) ? count + 1 : NULL,
-                                            (stride) ? stride + 1 : NULL)) != ESCDF_SUCCESS) {
-            H5Dclose(dtset_id);
-            H5Gclose(loc_id);
-            return err;
+        _get_level_name(level, name);
+        ndims = _get_level_dims(scalarfield, level, dims);
+        if ((err = utils_hdf5_check_dataset(loc_id, name, dims, ndims, &dtset_id)) != ESCDF_SUCCESS) {
+            break;
         }
+        err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode,
+                                       coarse, type_id, NULL, NULL, NULL);
         H5Dclose(dtset_id);
+        if (err != ESCDF_SUCCESS) {
+            break;
+        }
     }
-
-    H5Gclose(loc_id);
-    return ESCDF_SUCCESS;
+    if (fine != buf) {
+        free((double*)fine);
+    }
+    H5Tclose(type_id);
+    return err;
 }
 
-/**
- * This method is used to write values known on a slice of grid
- * points. The union of all slices among processors should correspond
- * to the box itself. Then each slices are written on disk in a packed
- * way, ordered by processor id. This is a collective call.
- *
- * The values @buf can use a non-default ordering, as defined by
- * @tbl, or a default ordering if @tbl is NULL. The size of @buf is
- * implicit and corresponds to the product of @len,
- * @scalarfield(real_or_complex) and
- * @scalarfield(number_of_components). If given, the size of @tbl in
- * given by @len.
- *
- * @param[in] scalarfield: instance of the scalarfield group.
- * @param[in] file_id: the handle on the opened HDF5 file.
- * @param[in] buf: values of the scalarfield on a slice of grid
- * points, with the full component values for each points.
- * @param[in] tbl: a lookup table that provides for each points in the
- * slice its index in the global zyx ordering.
- * @param[in] len: the size of the slice.
- * @return error code.
- */
-escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
-                                                                 escdf_handle_t *file_id,
-                                                                 const double *buf,
-                                                                 const unsigned int *tbl,
-                                                                 const hsize_t len)
+/* Get the lattice vectors, padded to a 3x3 matrix with the identity
+   in missing directions. Returns its determinant. */
+static double _get_lattice(const escdf_grid_scalarfield_t *scalarfield, double m[3][3])
 {
-    escdf_errno_t err;
-    hsize_t start[3], count[3];
+    unsigned int i, j, npd;
 
-    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
-    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            m[i][j] = (i < npd && j < npd) ?
+                scalarfield->cell.lattice_vectors[i * npd + j] : (double)(i == j);
+        }
+    }
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+        - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+        + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+/* The volume of the cell, from the lattice vectors. */
+static double _get_cell_volume(const escdf_grid_scalarfield_t *scalarfield)
+{
+    double m[3][3];
+
+    return fabs(_get_lattice(scalarfield, m));
+}
+
+/* Update min, max and sum with n values read with a given
+   stride. Four independent accumulators break the dependency chain,
+   so that the loop can be vectorised. */
+static void _reduce_values(const double *v, size_t n, size_t stride,
+                           double *vmin, double *vmax, double *vsum)
+{
+    double mn[4], mx[4], sm[4], x;
+    size_t j, k;
+
+    for (k = 0; k < 4; k++) {
+        mn[k] = *vmin;
+        mx[k] = *vmax;
+        sm[k] = 0.;
+    }
+    for (j = 0; j + 4 <= n; j += 4) {
+        for (k = 0; k < 4; k++) {
+            x = v[(j + k) * stride];
+            mn[k] = (x < mn[k]) ? x : mn[k];
+            mx[k] = (x > mx[k]) ? x : mx[k];
+            sm[k] += x;
+        }
+    }
+    for (; j < n; j++) {
+        x = v[j * stride];
+        mn[0] = (x < mn[0]) ? x : mn[0];
+        mx[0] = (x > mx[0]) ? x : mx[0];
+        sm[0] += x;
+    }
+    for (k = 0; k < 4; k++) {
+        *vmin = (mn[k] < *vmin) ? mn[k] : *vmin;
+        *vmax = (mx[k] > *vmax) ? mx[k] : *vmax;
+        *vsum += sm[k];
+    }
+}
+
+/* Compute the statistics of the values of len grid points, stored as
+   [number_of_components, len, real_or_complex] in buf, and write them
+   on the group. Grid point j is tbl[j] if tbl is given, offset + j
+   otherwise. With reduce, buf only holds the slice of this process
+   and the contributions of all processes are reduced first, so this
+   is a collective call. */
+static escdf_errno_t _write_statistics(const escdf_grid_scalarfield_t *scalarfield,
+                                       escdf_handle_t *file_id, hid_t loc_id,
+                                       const void *buf, hid_t mem_type_id,
+                                       const unsigned int *tbl,
+                                       hsize_t offset, hsize_t len, bool reduce)
+{
+    escdf_errno_t err;
+    hid_t dtset_id;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t j0, j, nb, nchunks, ichunk, ipos;
+    _chunk_key_t ck;
+    double *stats, *cmin, *cmax, *tmp, x, dv;
+    const double *v;
+    unsigned int c, iv, ncomp, nvalues, ndims;
+    size_t nvals, k;
+    bool isdbl;
+
+    ncomp = scalarfield->number_of_components.value;
+    nvalues = scalarfield->real_or_complex.value;
+    nvals = ncomp * nvalues;
+    /* minimum, maximum, sum and integral. */
+    stats = malloc(sizeof(double) * 4 * nvals);
+    for (k = 0; k < nvals; k++) {
+        stats[k] = HUGE_VAL;
+        stats[nvals + k] = -HUGE_VAL;
+        stats[2 * nvals + k] = 0.;
+    }
+    cmin = cmax = NULL;
+    nchunks = 0;
+    if (scalarfield->use_chunk_statistics.is_set && scalarfield->use_chunk_statistics.value) {
+        _init_chunk_key(scalarfield, &ck);
+        nchunks = 1;
+        for (c = 0; c < ck.npd; c++) {
+            nchunks *= ck.nchunks[c];
+        }
+        cmin = malloc(sizeof(double) * nvals * nchunks);
+        cmax = malloc(sizeof(double) * nvals * nchunks);
+        for (k = 0; k < nvals * nchunks; k++) {
+            cmin[k] = HUGE_VAL;
+            cmax[k] = -HUGE_VAL;
+        }
+    }
+
+    isdbl = (H5Tequal(mem_type_id, H5T_NATIVE_DOUBLE) > 0);
+    tmp = (isdbl) ? NULL : malloc(sizeof(double) * STATISTICS_BLOCK_SIZE * nvalues);
+    for (c = 0; c < ncomp; c++) {
+        for (j0 = 0; j0 < len; j0 += STATISTICS_BLOCK_SIZE) {
+            nb = (len - j0 < STATISTICS_BLOCK_SIZE) ? len - j0 : STATISTICS_BLOCK_SIZE;
+            if (isdbl) {
+                v = (const double*)buf + (c * len + j0) * nvalues;
+            } else {
+                for (k = 0; k < nb * nvalues; k++) {
+                    tmp[k] = ((const float*)buf)[(c * len + j0) * nvalues + k];
+                }
+                v = tmp;
+            }
+            for (iv = 0; iv < nvalues; iv++) {
+                _reduce_values(v + iv, nb, nvalues, stats + c * nvalues + iv,
+                               stats + nvals + c * nvalues + iv,
+                               stats + 2 * nvals + c * nvalues + iv);
+            }
+            if (cmin) {
+                for (j = 0; j < nb; j++) {
+                    ichunk = _get_chunk_index(&ck, (tbl) ? tbl[j0 + j] : offset + j0 + j);
+                    for (iv = 0; iv < nvalues; iv++) {
+                        ipos = (c * nchunks + ichunk) * nvalues + iv;
+                        x = v[j * nvalues + iv];
+                        cmin[ipos] = (x < cmin[ipos]) ? x : cmin[ipos];
+                        cmax[ipos] = (x > cmax[ipos]) ? x : cmax[ipos];
+                    }
+                }
+            }
+        }
+    }
+    free(tmp);
+
+#ifdef HAVE_MPI
+    if (reduce && file_id->mpi_size > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, stats, nvals, MPI_DOUBLE, MPI_MIN, file_id->comm);
+        MPI_Allreduce(MPI_IN_PLACE, stats + nvals, nvals, MPI_DOUBLE, MPI_MAX, file_id->comm);
+        MPI_Allreduce(MPI_IN_PLACE, stats + 2 * nvals, nvals, MPI_DOUBLE, MPI_SUM, file_id->comm);
+        if (cmin) {
+            MPI_Allreduce(MPI_IN_PLACE, cmin, nvals * nchunks, MPI_DOUBLE, MPI_MIN, file_id->comm);
+            MPI_Allreduce(MPI_IN_PLACE, cmax, nvals * nchunks, MPI_DOUBLE, MPI_MAX, file_id->comm);
+        }
+    }
+#else
+    (void)reduce;
+#endif
+
+    /* The integral is the sum times the volume element. */
+    dv = (scalarfield->cell.lattice_vectors) ?
+        _get_cell_volume(scalarfield) / _get_number_of_points(scalarfield) : 0.;
+    for (k = 0; k < nvals; k++) {
+        stats[3 * nvals + k] = stats[2 * nvals + k] * dv;
+    }
+
+    dims[0] = ncomp;
+    dims[1] = nvalues;
+    if ((err = utils_hdf5_write_attr(loc_id, "values_on_grid_minimum", H5T_IEEE_F64LE,
+                                     dims, 2, H5T_NATIVE_DOUBLE, stats)) != ESCDF_SUCCESS ||
+        (err = utils_hdf5_write_attr(loc_id, "values_on_grid_maximum", H5T_IEEE_F64LE,
+                                     dims, 2, H5T_NATIVE_DOUBLE, stats + nvals)) != ESCDF_SUCCESS ||
+        (err = utils_hdf5_write_attr(loc_id, "values_on_grid_sum", H5T_IEEE_F64LE,
+                                     dims, 2, H5T_NATIVE_DOUBLE, stats + 2 * nvals)) != ESCDF_SUCCESS ||
+        (err = utils_hdf5_write_attr(loc_id, "values_on_grid_integral", H5T_IEEE_F64LE,
+                                     dims, 2, H5T_NATIVE_DOUBLE, stats + 3 * nvals)) != ESCDF_SUCCESS) {
+        free(cmin);
+        free(cmax);
+        free(stats);
+        return err;
+    }
+    free(stats);
+
+    if (cmin) {
+        ndims = _get_chunk_statistics_dims(scalarfield, dims);
+        if ((err = utils_hdf5_check_dataset(loc_id, "values_on_grid_chunk_minimum",
+                                            dims, ndims, &dtset_id)) == ESCDF_SUCCESS) {
+            err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode, cmin,
+                                           H5T_NATIVE_DOUBLE, NULL, NULL, NULL);
+            H5Dclose(dtset_id);
+        }
+        if (err == ESCDF_SUCCESS &&
+            (err = utils_hdf5_check_dataset(loc_id, "values_on_grid_chunk_maximum",
+                                            dims, ndims, &dtset_id)) == ESCDF_SUCCESS) {
+            err = utils_hdf5_write_dataset(dtset_id, file_id->transfer_mode, cmax,
+                                           H5T_NATIVE_DOUBLE, NULL, NULL, NULL);
+            H5Dclose(dtset_id);
+        }
+        free(cmin);
+        free(cmax);
+        return err;
+    }
+    return ESCDF_SUCCESS;
+}
+
+static escdf_errno_t _write_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                           escdf_handle_t *file_id,
+                                           const void *buf, hid_t mem_type_id,
+                                           const unsigned int *tbl,
+                                           const hsize_t *start,
+                                           const hsize_t *count,
+                                           const hsize_t *stride,
+                                           const hsize_t *mem_dims,
+                                           unsigned int mem_ndims,
+                                           const hsize_t *mem_start,
+                                           const hsize_t *mem_count,
+                                           const hsize_t *mem_stride)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id, xfer_id;
+    hsize_t i, len;
+    double *dbuf;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    if (tbl != NULL) {
+        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
+                          !scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+    } else {
+        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
+                          scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+    }
+    
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+
+    /* Write buf in dataset "values_on_grid". */
+    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    if ((xfer_id = _get_values_on_grid_xfer(scalarfield, file_id)) < 0) {
+        H5Tclose(type_id);
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(xfer_id);
+    }
+    err = utils_hdf5_write_dataset_mem(dtset_id, xfer_id,
+                                       buf, type_id, start, count, stride,
+                                       mem_dims, mem_ndims, mem_start, mem_count, mem_stride);
+    if (xfer_id != file_id->transfer_mode) {
+        H5Pclose(xfer_id);
+    }
+    H5Tclose(type_id);
+    if (err != ESCDF_SUCCESS) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        return err;
+    }
+    H5Dclose(dtset_id);
+
+    /* When the full field is given, also write its statistics. */
+    if (start == NULL && mem_dims == NULL) {
+        if ((err = _write_statistics(scalarfield, file_id, loc_id, buf, mem_type_id, tbl,
+                                     0, _get_number_of_points(scalarfield), false)) != ESCDF_SUCCESS) {
+            H5Gclose(loc_id);
+            return err;
+        }
+    }
+
+    /* When the full field is given, also write the coarsened levels. */
+    if (scalarfield->number_of_levels.is_set && scalarfield->number_of_levels.value > 0 &&
+        tbl == NULL && start == NULL && mem_dims == NULL) {
+        if (H5Tequal(mem_type_id, H5T_NATIVE_DOUBLE) > 0) {
+            err = _write_levels(scalarfield, file_id, loc_id, buf);
+        } else {
+            len = scalarfield->number_of_components.value * _get_number_of_points(scalarfield) *
+                scalarfield->real_or_complex.value;
+            dbuf = malloc(sizeof(double) * len);
+            for (i = 0; i < len; i++) {
+                dbuf[i] = ((const float*)buf)[i];
+            }
+            err = _write_levels(scalarfield, file_id, loc_id, dbuf);
+            free(dbuf);
+        }
+        if (err != ESCDF_SUCCESS) {
+            H5Gclose(loc_id);
+            return err;
+        }
+    }
+
+    /* Write the lookup table. */
+    if (tbl != NULL) {
+        if ((err = _write_grid_ordering(scalarfield, file_id, loc_id, tbl,
+                                        (start) ? start + 1 : NULL,
+                                        (count) ? count + 1 : NULL,
+                                        (stride) ? stride + 1 : NULL)) != ESCDF_SUCCESS) {
+            H5Gclose(loc_id);
+            return err;
+        }
+    }
+
+    H5Gclose(loc_id);
+    return ESCDF_SUCCESS;
+}
+
+/* Write the values of the range [offset, offset + len[ of grid points
+   in the default ordering, in a single transfer whatever the layout. */
+static escdf_errno_t _write_values_on_grid_range(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 const void *buf, hid_t mem_type_id,
+                                                 const unsigned int *tbl,
+                                                 hsize_t offset, hsize_t len)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id, xfer_id;
+    hsize_t start[5 * MAX_VALUES_ON_GRID_NDIMS], count[5 * MAX_VALUES_ON_GRID_NDIMS];
+    size_t nboxes;
+
+    if (tbl != NULL) {
+        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
+                          !scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+    } else {
+        FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
+                          scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+    }
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+
+    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    if ((xfer_id = _get_values_on_grid_xfer(scalarfield, file_id)) < 0) {
+        H5Tclose(type_id);
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(xfer_id);
+    }
+    nboxes = _get_range_boxes(scalarfield, offset, len, start, count);
+    err = utils_hdf5_write_dataset_boxes(dtset_id, xfer_id,
+                                         buf, type_id, nboxes, start, count, NULL);
+    if (xfer_id != file_id->transfer_mode) {
+        H5Pclose(xfer_id);
+    }
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+    if (err != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+
+    if (tbl != NULL) {
+        if ((err = _write_grid_ordering(scalarfield, file_id, loc_id, tbl,
+                                        &offset, &len, NULL)) != ESCDF_SUCCESS) {
+            H5Gclose(loc_id);
+            return err;
+        }
+    }
+
+    H5Gclose(loc_id);
+    return ESCDF_SUCCESS;
+}
+
+/* Write the slice of len grid points starting at offset in the
+   default ordering, or ordered as given by tbl, whatever the layout. */
+static escdf_errno_t _write_values_on_grid_slice(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 const void *buf, hid_t mem_type_id,
+                                                 const unsigned int *tbl,
+                                                 hsize_t offset, hsize_t len)
+{
+    hsize_t start[3], count[3];
+
+    /* With the grid layout, a slice is a union of boxes. */
+    if (_use_grid_layout(scalarfield)) {
+        return _write_values_on_grid_range(scalarfield, file_id, buf, mem_type_id,
+                                           tbl, offset, len);
+    }
+
+    start[0] = 0;
+    start[1] = offset;
+    start[2] = 0;
+    count[0] = scalarfield->number_of_components.value;
+    count[1] = len;
+    count[2] = scalarfield->real_or_complex.value;
+    return _write_values_on_grid(scalarfield, file_id, buf, mem_type_id, tbl,
+                                 start, count, NULL, NULL, 0, NULL, NULL, NULL);
+}
+
+#ifdef HAVE_MPI
+/* Gather the slices of the aggregation group of the handle on its
+   aggregator. The slices of a group are not contiguous in general,
+   e.g. for nodes with interleaved ranks, so the aggregator merges
+   them in runs of contiguous grid points and writes each run as a
+   single slice. All the ranks of the handle take part in as many
+   writes as the largest number of runs, with empty selections when
+   they have nothing to write, as collective transfers and metadata
+   operations require. */
+static escdf_errno_t _write_values_on_grid_aggregated(const escdf_grid_scalarfield_t *scalarfield,
+                                                      escdf_handle_t *file_id,
+                                                      const void *buf, hid_t mem_type_id,
+                                                      const unsigned int *tbl,
+                                                      hsize_t offset, hsize_t len)
+{
+    escdf_errno_t err, err_r;
+    unsigned long long int sel[2], *gsel;
+    size_t ncomp, val_size, c, glen, *order, *run_of, *counts, *displs, *tcounts, *tdispls;
+    size_t *run_start, *run_len, *run_pos, o;
+    int grank, gsize, g, h, nruns, maxruns, r;
+    char *gbuf;
+    unsigned int *gtbl;
+
+    MPI_Comm_rank(file_id->agg_comm, &grank);
+    MPI_Comm_size(file_id->agg_comm, &gsize);
+
+    ncomp = scalarfield->number_of_components.value;
+    val_size = scalarfield->real_or_complex.value * H5Tget_size(mem_type_id);
+
+    sel[0] = offset;
+    sel[1] = len;
+    gsel = NULL;
+    order = run_of = counts = displs = tcounts = tdispls = NULL;
+    run_start = run_len = run_pos = NULL;
+    gbuf = NULL;
+    gtbl = NULL;
+    glen = 0;
+    nruns = 0;
+    if (grank == 0) {
+        gsel = malloc(sizeof(unsigned long long int) * 2 * gsize);
+    }
+    MPI_Gather(sel, 2, MPI_UNSIGNED_LONG_LONG, gsel, 2, MPI_UNSIGNED_LONG_LONG,
+               0, file_id->agg_comm);
+
+    if (grank == 0) {
+        order = malloc(sizeof(size_t) * gsize);
+        run_of = malloc(sizeof(size_t) * gsize);
+        run_start = malloc(sizeof(size_t) * gsize);
+        run_len = malloc(sizeof(size_t) * gsize);
+        run_pos = malloc(sizeof(size_t) * gsize);
+        counts = malloc(sizeof(size_t) * gsize);
+        displs = malloc(sizeof(size_t) * gsize);
+        tcounts = malloc(sizeof(size_t) * gsize);
+        tdispls = malloc(sizeof(size_t) * gsize);
+
+        /* Sort the slices by offset, groups being small. */
+        for (g = 0; g < gsize; g++) {
+            for (h = g; h > 0 && gsel[2 * order[h - 1]] > gsel[2 * g]; h--) {
+                order[h] = order[h - 1];
+            }
+            order[h] = g;
+        }
+        /* Merge them in runs, run_pos being the position of a run in the
+           gathered points. */
+        for (g = 0; g < gsize; g++) {
+            o = order[g];
+            if (nruns == 0 || gsel[2 * o] != run_start[nruns - 1] + run_len[nruns - 1]) {
+                run_start[nruns] = gsel[2 * o];
+                run_len[nruns] = 0;
+                run_pos[nruns] = glen;
+                nruns += 1;
+            }
+            run_of[o] = nruns - 1;
+            run_len[nruns - 1] += gsel[2 * o + 1];
+            glen += gsel[2 * o + 1];
+        }
+        gbuf = malloc(ncomp * glen * val_size);
+        if (tbl) {
+            gtbl = malloc(sizeof(unsigned int) * glen);
+        }
+    }
+
+    /* Values are stored as [number_of_components, len, real_or_complex]
+       for each run. */
+    for (c = 0; c < ncomp; c++) {
+        if (grank == 0) {
+            for (g = 0; g < gsize; g++) {
+                r = run_of[g];
+                counts[g] = gsel[2 * g + 1] * val_size;
+                displs[g] = (ncomp * run_pos[r] + c * run_len[r] +
+                             gsel[2 * g] - run_start[r]) * val_size;
+            }
+        }
+        _gather_bytes((const char*)buf + c * len * val_size, len * val_size,
+                      gbuf, counts, displs, file_id->agg_comm);
+    }
+    if (tbl) {
+        if (grank == 0) {
+            for (g = 0; g < gsize; g++) {
+                r = run_of[g];
+                tcounts[g] = gsel[2 * g + 1] * sizeof(unsigned int);
+                tdispls[g] = (run_pos[r] + gsel[2 * g] - run_start[r]) * sizeof(unsigned int);
+            }
+        }
+        _gather_bytes(tbl, len * sizeof(unsigned int), gtbl, tcounts, tdispls,
+                      file_id->agg_comm);
+    }
+
+    MPI_Allreduce(&nruns, &maxruns, 1, MPI_INT, MPI_MAX, file_id->comm);
+    err = ESCDF_SUCCESS;
+    for (r = 0; r < maxruns; r++) {
+        if (r < nruns) {
+            err_r = _write_values_on_grid_slice(scalarfield, file_id,
+                                                gbuf + ncomp * run_pos[r] * val_size, mem_type_id,
+                                                (gtbl) ? gtbl + run_pos[r] : NULL,
+                                                run_start[r], run_len[r]);
+        } else {
+            err_r = _write_values_on_grid_slice(scalarfield, file_id, buf, mem_type_id,
+                                                tbl, offset, 0);
+        }
+        if (err == ESCDF_SUCCESS) {
+            err = err_r;
+        }
+    }
+
+    free(gsel);
+    free(order);
+    free(run_of);
+    free(run_start);
+    free(run_len);
+    free(run_pos);
+    free(counts);
+    free(displs);
+    free(tcounts);
+    free(tdispls);
+    free(gbuf);
+    free(gtbl);
+    return err;
+}
+#endif
+
+/**
+ * This method is used to write values known on a slice of grid
+ * points. The union of all slices among processors should correspond
+ * to the box itself. Then each slices are written on disk in a packed
+ * way, ordered by processor id. This is a collective call.
+ *
+ * When the handle defines aggregation groups, see
+ * escdf_handle_set_aggregation(), the slices of each group are
+ * gathered and written by its aggregator.
+ *
+ * The values @buf can use a non-default ordering, as defined by
+ * @tbl, or a default ordering if @tbl is NULL. The size of @buf is
+ * implicit and corresponds to the product of @len,
+ * @scalarfield(real_or_complex) and
+ * @scalarfield(number_of_components). If given, the size of @tbl in
+ * given by @len.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[in] buf: values of the scalarfield on a slice of grid
+ * points, with the full component values for each points.
+ * @param[in] tbl: a lookup table that provides for each points in the
+ * slice its index in the global zyx ordering.
+ * @param[in] offset: the offset of the slice in the global zyx
+ * ordering, as given by escdf_grid_scalarfield_get_slice_offset(),
+ * or NULL to compute it collectively.
+ * @param[in] len: the size of the slice.
+ * @return error code.
+ */
+static escdf_errno_t _write_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
+                                                  escdf_handle_t *file_id,
+                                                  const void *buf, hid_t mem_type_id,
+                                                  const unsigned int *tbl,
+                                                  const hsize_t *offset,
+                                                  const hsize_t len)
+{
+    escdf_errno_t err;
+    hid_t loc_id;
+    hsize_t start[3];
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+
+    start[0] = 0;
+    start[1] = 0;
+    start[2] = 0;
+
+    /* Modify the start[1] value from the scan of len. */
+    if (offset) {
+        start[1] = *offset;
+    } else {
+        err = _get_proc_grid_offset(&start[1], file_id,
+                                    scalarfield->cell.number_of_physical_dimensions.value,
+                                    scalarfield->number_of_grid_points, len);
+        FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+    }
+
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1 && file_id->agg_comm != MPI_COMM_NULL) {
+        err = _write_values_on_grid_aggregated(scalarfield, file_id, buf, mem_type_id,
+                                               tbl, start[1], len);
+    } else {
+        err = _write_values_on_grid_slice(scalarfield, file_id, buf, mem_type_id,
+                                          tbl, start[1], len);
+    }
+#else
+    err = _write_values_on_grid_slice(scalarfield, file_id, buf, mem_type_id,
+                                      tbl, start[1], len);
+#endif
+    FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+
+    /* The slices cover the full field, so statistics can be reduced. */
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    err = _write_statistics(scalarfield, file_id, loc_id, buf, mem_type_id, tbl,
+                            start[1], len, true);
+    H5Gclose(loc_id);
+    return err;
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
+                                                                 escdf_handle_t *file_id,
+                                                                 const double *buf,
+                                                                 const unsigned int *tbl,
+                                                                 const hsize_t len)
+{
+    return _write_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                        tbl, NULL, len);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                    escdf_handle_t *file_id,
+                                                                    const double *buf,
+                                                                    const unsigned int *tbl,
+                                                                    const hsize_t offset,
+                                                                    const hsize_t len)
+{
+    return _write_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                        tbl, &offset, len);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                       escdf_handle_t *file_id,
+                                                                       const float *buf,
+                                                                       const unsigned int *tbl,
+                                                                       const hsize_t len)
+{
+    return _write_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                        tbl, NULL, len);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_float_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                          escdf_handle_t *file_id,
+                                                                          const float *buf,
+                                                                          const unsigned int *tbl,
+                                                                          const hsize_t offset,
+                                                                          const hsize_t len)
+{
+    return _write_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                        tbl, &offset, len);
+}
+
+/**
+ * Same as _write_values_on_grid_sliced() for a non-default ordering
+ * given by @tbl, but the values are first sent to the processes
+ * owning them in a block decomposition of the default ordering,
+ * with a single all-to-all exchange. Each process then writes a
+ * contiguous range, and the file is stored in the default ordering,
+ * without grid_ordering table. This is a collective call.
+ */
+static escdf_errno_t _write_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                         escdf_handle_t *file_id,
+                                                         const void *buf, hid_t mem_type_id,
+                                                         const unsigned int *tbl,
+                                                         const hsize_t len)
+{
+    escdf_errno_t err;
+    unsigned long long int check[2], index;
+    hsize_t npoints, offset, mylen, i, c, nrecv;
+    size_t ncomp, nval, elem_size, val_size, rec_size;
+    int *sendcounts, *senddispls, *fill, dest, ok;
+    char *sendbuf, *recvbuf, *block, *rec, *received;
+#ifdef HAVE_MPI
+    int *recvcounts, *recvdispls;
+    MPI_Datatype rec_type;
+#endif
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set &&
+                      scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(tbl || len == 0, ESCDF_EVALUE);
+
+    npoints = _get_number_of_points(scalarfield);
+
+    /* Agree on the validity of the slices before any exchange. */
+    check[0] = (unsigned long long int)len;
+    check[1] = 0;
+    for (i = 0; i < len; i++) {
+        if (tbl[i] >= npoints) {
+            check[1] += 1;
+        }
+    }
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, check, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, file_id->comm);
+    }
+#endif
+    FULFILL_OR_RETURN(check[1] == 0, ESCDF_ERANGE);
+    FULFILL_OR_RETURN((hsize_t)check[0] == npoints, ESCDF_ESIZE);
+
+    ncomp = scalarfield->number_of_components.value;
+    nval = scalarfield->real_or_complex.value;
+    elem_size = H5Tget_size(mem_type_id);
+    val_size = nval * elem_size;
+    rec_size = sizeof(unsigned long long int) + ncomp * val_size;
+    _get_block_slice(npoints, file_id->mpi_size, file_id->mpi_rank, &offset, &mylen);
+
+    /* Pack one record per point, with its global index and all its
+       component values, grouped by owner. Counts are in records. */
+    sendcounts = calloc(file_id->mpi_size, sizeof(int));
+    senddispls = malloc(sizeof(int) * file_id->mpi_size);
+    fill = malloc(sizeof(int) * file_id->mpi_size);
+    for (i = 0; i < len; i++) {
+        sendcounts[_get_block_owner(npoints, file_id->mpi_size, tbl[i])] += 1;
+    }
+    senddispls[0] = 0;
+    for (dest = 1; dest < file_id->mpi_size; dest++) {
+        senddispls[dest] = senddispls[dest - 1] + sendcounts[dest - 1];
+    }
+    memcpy(fill, senddispls, sizeof(int) * file_id->mpi_size);
+    sendbuf = malloc(len * rec_size + 1);
+    for (i = 0; i < len; i++) {
+        dest = _get_block_owner(npoints, file_id->mpi_size, tbl[i]);
+        rec = sendbuf + (size_t)fill[dest] * rec_size;
+        index = tbl[i];
+        memcpy(rec, &index, sizeof(unsigned long long int));
+        for (c = 0; c < ncomp; c++) {
+            memcpy(rec + sizeof(unsigned long long int) + c * val_size,
+                   (const char*)buf + (c * len + i) * val_size, val_size);
+        }
+        fill[dest] += 1;
+    }
+    free(fill);
+
+    recvbuf = sendbuf;
+    nrecv = len;
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        recvcounts = malloc(sizeof(int) * file_id->mpi_size);
+        recvdispls = malloc(sizeof(int) * file_id->mpi_size);
+        MPI_Alltoall(sendcounts, 1, MPI_INT, recvcounts, 1, MPI_INT, file_id->comm);
+        recvdispls[0] = 0;
+        for (dest = 1; dest < file_id->mpi_size; dest++) {
+            recvdispls[dest] = recvdispls[dest - 1] + recvcounts[dest - 1];
+        }
+        nrecv = (hsize_t)recvdispls[file_id->mpi_size - 1] + recvcounts[file_id->mpi_size - 1];
+        recvbuf = malloc(nrecv * rec_size + 1);
+        MPI_Type_contiguous((int)rec_size, MPI_BYTE, &rec_type);
+        MPI_Type_commit(&rec_type);
+        MPI_Alltoallv(sendbuf, sendcounts, senddispls, rec_type,
+                      recvbuf, recvcounts, recvdispls, rec_type, file_id->comm);
+        MPI_Type_free(&rec_type);
+        free(recvcounts);
+        free(recvdispls);
+        free(sendbuf);
+    }
+#endif
+    free(sendcounts);
+    free(senddispls);
+
+    /* Unpack the records in the default ordering of the owned range,
+       marking the received points. */
+    block = malloc(ncomp * mylen * val_size + 1);
+    received = calloc(mylen + 1, sizeof(char));
+    ok = 1;
+    for (i = 0; i < nrecv; i++) {
+        rec = recvbuf + i * rec_size;
+        memcpy(&index, rec, sizeof(unsigned long long int));
+        if (received[index - offset]) {
+            ok = 0;
+        }
+        received[index - offset] = 1;
+        for (c = 0; c < ncomp; c++) {
+            memcpy(block + (c * mylen + (index - offset)) * val_size,
+                   rec + sizeof(unsigned long long int) + c * val_size, val_size);
+        }
+    }
+    free(recvbuf);
+    free(received);
+
+    /* Each owned point must have been received exactly once: without
+       duplicates, receiving as many points as owned means none is
+       missing. All the ranks fail together otherwise. */
+    ok = ok && (nrecv == mylen);
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_LAND, file_id->comm);
+    }
+#endif
+    if (!ok) {
+        free(block);
+        RETURN_WITH_ERROR(ESCDF_ESIZE);
+    }
+
+    err = _write_values_on_grid_sliced(scalarfield, file_id, block, mem_type_id,
+                                       NULL, &offset, mylen);
+    free(block);
+    return err;
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                                        escdf_handle_t *file_id,
+                                                                        const double *buf,
+                                                                        const unsigned int *tbl,
+                                                                        const hsize_t len)
+{
+    return _write_values_on_grid_redistributed(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                               tbl, len);
+}
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_redistributed_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                              escdf_handle_t *file_id,
+                                                                              const float *buf,
+                                                                              const unsigned int *tbl,
+                                                                              const hsize_t len)
+{
+    return _write_values_on_grid_redistributed(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                               tbl, len);
+}
+
+static escdf_errno_t _read_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                          escdf_handle_t *file_id,
+                                          void *buf, hid_t mem_type_id,
+                                          const hsize_t *start,
+                                          const hsize_t *count,
+                                          const hsize_t *stride,
+                                          const hsize_t *mem_dims,
+                                          unsigned int mem_ndims,
+                                          const hsize_t *mem_start,
+                                          const hsize_t *mem_count,
+                                          const hsize_t *mem_stride)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    
+    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    err = utils_hdf5_read_dataset_mem(dtset_id, file_id->transfer_mode,
+                                      buf, type_id, start, count, stride,
+                                      mem_dims, mem_ndims, mem_start, mem_count, mem_stride);
+    H5Tclose(type_id);
+    if (err != ESCDF_SUCCESS) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        return err;
+    }
+
+    H5Dclose(dtset_id);
+    H5Gclose(loc_id);
+    return ESCDF_SUCCESS;
+}
+/* Read the union of several disjoint boxes of values_on_grid in a
+   single transfer. The values are stored following the order of the
+   dataset. */
+static escdf_errno_t _read_values_on_grid_boxes(const escdf_grid_scalarfield_t *scalarfield,
+                                                escdf_handle_t *file_id,
+                                                void *buf, hid_t mem_type_id,
+                                                size_t nboxes,
+                                                const hsize_t *start,
+                                                const hsize_t *count)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id;
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+
+    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    err = utils_hdf5_read_dataset_boxes(dtset_id, file_id->transfer_mode,
+                                        buf, type_id, nboxes, start, count, NULL);
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+    H5Gclose(loc_id);
+    return err;
+}
+
+/* Build the boxes of values_on_grid that cover a box of grid points,
+   given in number_of_grid_points order: a single hyperslab with the
+   grid layout, one line along x per box otherwise. The boxes are
+   allocated and should be freed by the caller. Returns the number of
+   boxes. */
+static size_t _get_grid_box_selection(const escdf_grid_scalarfield_t *scalarfield,
+                                      const hsize_t *start, const hsize_t *count,
+                                      hsize_t **bstart, hsize_t **bcount)
+{
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t point, mult, idx;
+    size_t ibox, nboxes;
+    unsigned int i, ndims, npd;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    nboxes = 1;
+    if (!_use_grid_layout(scalarfield)) {
+        for (i = 1; i < npd; i++) {
+            nboxes *= count[i];
+        }
+    }
+    *bstart = malloc(sizeof(hsize_t) * nboxes * ndims);
+    *bcount = malloc(sizeof(hsize_t) * nboxes * ndims);
+    for (ibox = 0; ibox < nboxes; ibox++) {
+        (*bstart)[ibox * ndims] = 0;
+        (*bcount)[ibox * ndims] = dims[0];
+        if (_use_grid_layout(scalarfield)) {
+            for (i = 0; i < npd; i++) {
+                (*bstart)[ibox * ndims + 1 + i] = start[npd - 1 - i];
+                (*bcount)[ibox * ndims + 1 + i] = count[npd - 1 - i];
+            }
+        } else {
+            idx = ibox;
+            point = start[0];
+            mult = scalarfield->number_of_grid_points[0];
+            for (i = 1; i < npd; i++) {
+                point += (start[i] + idx % count[i]) * mult;
+                idx /= count[i];
+                mult *= scalarfield->number_of_grid_points[i];
+            }
+            (*bstart)[ibox * ndims + 1] = point;
+            (*bcount)[ibox * ndims + 1] = count[0];
+        }
+        if (!_use_complex_type(scalarfield)) {
+            (*bstart)[ibox * ndims + ndims - 1] = 0;
+            (*bcount)[ibox * ndims + ndims - 1] = dims[ndims - 1];
+        }
+    }
+    return nboxes;
+}
+
+static escdf_errno_t _read_values_on_grid_box(const escdf_grid_scalarfield_t *scalarfield,
+                                              escdf_handle_t *file_id,
+                                              void *buf, hid_t mem_type_id,
+                                              const hsize_t *start,
+                                              const hsize_t *count)
+{
+    escdf_errno_t err;
+    hsize_t *bstart, *bcount;
+    size_t nboxes;
+    unsigned int i, npd;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(start && count, ESCDF_EVALUE);
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    for (i = 0; i < npd; i++) {
+        FULFILL_OR_RETURN(start[i] + count[i] <= scalarfield->number_of_grid_points[i],
+                          ESCDF_ERANGE);
+    }
+
+    nboxes = _get_grid_box_selection(scalarfield, start, count, &bstart, &bcount);
+    err = _read_values_on_grid_boxes(scalarfield, file_id, buf, mem_type_id,
+                                     nboxes, bstart, bcount);
+    free(bstart);
+    free(bcount);
+    return err;
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_box(const escdf_grid_scalarfield_t *scalarfield,
+                                                             escdf_handle_t *file_id, double *buf,
+                                                             const hsize_t *start,
+                                                             const hsize_t *count)
+{
+    return _read_values_on_grid_box(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                    start, count);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_box_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                   escdf_handle_t *file_id, float *buf,
+                                                                   const hsize_t *start,
+                                                                   const hsize_t *count)
+{
+    return _read_values_on_grid_box(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                    start, count);
+}
+
+/* Compute the inverse of the lattice vectors, padded to a 3x3 matrix
+   with the identity in missing directions. */
+static escdf_errno_t _get_inverse_lattice(const escdf_grid_scalarfield_t *scalarfield,
+                                          double inv[3][3])
+{
+    double m[3][3], det;
+    unsigned int i, j;
+
+    det = _get_lattice(scalarfield, m);
+    FULFILL_OR_RETURN(det != 0., ESCDF_EVALUE);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            inv[j][i] = (m[(i + 1) % 3][(j + 1) % 3] * m[(i + 2) % 3][(j + 2) % 3] -
+                         m[(i + 1) % 3][(j + 2) % 3] * m[(i + 2) % 3][(j + 1) % 3]) / det;
+        }
+    }
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_get_region(const escdf_grid_scalarfield_t *scalarfield,
+                                                const double *lower,
+                                                const double *upper,
+                                                hsize_t *start,
+                                                hsize_t *count)
+{
+    escdf_errno_t err;
+    double inv[3][3], fmin[3], fmax[3], r[3], f, lo, hi;
+    unsigned int i, j, corner, npd, n;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->cell.lattice_vectors, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(lower && upper && start && count, ESCDF_EVALUE);
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    for (i = 0; i < npd; i++) {
+        FULFILL_OR_RETURN(lower[i] <= upper[i], ESCDF_EVALUE);
+    }
+    if ((err = _get_inverse_lattice(scalarfield, inv)) != ESCDF_SUCCESS) {
+        return err;
+    }
+
+    /* Bounds of the box in reduced coordinates, from its corners. A
+       position is r = sum_i f_i a_i, with a_i the lattice vectors. */
+    for (j = 0; j < npd; j++) {
+        fmin[j] = HUGE_VAL;
+        fmax[j] = -HUGE_VAL;
+    }
+    for (corner = 0; corner < (1u << npd); corner++) {
+        for (i = 0; i < 3; i++) {
+            r[i] = (i >= npd) ? 0. : ((corner >> i) & 1) ? upper[i] : lower[i];
+        }
+        for (j = 0; j < npd; j++) {
+            f = r[0] * inv[0][j] + r[1] * inv[1][j] + r[2] * inv[2][j];
+            fmin[j] = (f < fmin[j]) ? f : fmin[j];
+            fmax[j] = (f > fmax[j]) ? f : fmax[j];
+        }
+    }
+
+    /* Grid point k along direction j is at f_j = k / n_j. Take the
+       grid points enclosing the box, restricted to the cell. */
+    for (j = 0; j < npd; j++) {
+        n = scalarfield->number_of_grid_points[j];
+        lo = floor(fmin[j] * n);
+        hi = ceil(fmax[j] * n);
+        lo = (lo < 0.) ? 0. : lo;
+        hi = (hi > n - 1) ? n - 1 : hi;
+        FULFILL_OR_RETURN(lo <= hi, ESCDF_ERANGE);
+        start[j] = (hsize_t)lo;
+        count[j] = (hsize_t)(hi - lo) + 1;
+    }
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_read_region(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 double *buf,
+                                                 const double *lower,
+                                                 const double *upper)
+{
+    escdf_errno_t err;
+    hsize_t start[3], count[3];
+
+    if ((err = escdf_grid_scalarfield_get_region(scalarfield, lower, upper,
+                                                 start, count)) != ESCDF_SUCCESS) {
+        return err;
+    }
+    return _read_values_on_grid_box(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                    start, count);
+}
+
+/* Split the range [start - nghost, start + count + nghost[ along one
+   direction into segments within the grid, wrapping around for
+   periodic directions. For each segment, seg holds the first grid
+   point, the length and the offset in the extended range. Returns the
+   number of segments. */
+static unsigned int _get_halo_segments(hsize_t n, bool periodic,
+                                       hsize_t start, hsize_t count,
+                                       unsigned int nghost, hsize_t *seg)
+{
+    long long int pos, lo, hi, first, len;
+    unsigned int nseg;
+
+    lo = (long long int)start - nghost;
+    hi = (long long int)(start + count) + nghost;
+    nseg = 0;
+    if (!periodic) {
+        first = (lo < 0) ? 0 : lo;
+        len = ((hi > (long long int)n) ? (long long int)n : hi) - first;
+        seg[0] = first;
+        seg[1] = len;
+        seg[2] = first - lo;
+        return 1;
+    }
+    for (pos = lo; pos < hi; pos += len) {
+        first = ((pos % (long long int)n) + n) % n;
+        len = n - first;
+        len = (hi - pos < len) ? hi - pos : len;
+        seg[nseg * 3 + 0] = first;
+        seg[nseg * 3 + 1] = len;
+        seg[nseg * 3 + 2] = pos - lo;
+        nseg += 1;
+    }
+    return nseg;
+}
+
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_halo(const escdf_grid_scalarfield_t *scalarfield,
+                                                              escdf_handle_t *file_id,
+                                                              double *buf,
+                                                              const hsize_t *start,
+                                                              const hsize_t *count,
+                                                              unsigned int nghost)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t *seg[3], pstart[3], pcount[3], len;
+    unsigned int nseg[3], iseg[3];
+    hsize_t mem_dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t mem_start[MAX_VALUES_ON_GRID_NDIMS], mem_count[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t *bstart, *bcount;
+    size_t nboxes;
+    unsigned int i, j, ndims, mem_ndims, npd, nreads, maxreads;
+    bool done, empty;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->cell.dimension_types, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(start && count, ESCDF_EVALUE);
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    for (i = 0; i < npd; i++) {
+        FULFILL_OR_RETURN(start[i] + count[i] <= scalarfield->number_of_grid_points[i],
+                          ESCDF_ERANGE);
+    }
+
+    /* The user buffer is a dense [number_of_components, ez, ey, ex,
+       real_or_complex] array, with e = count + 2 * nghost. Ghost
+       values outside of non periodic directions are set to zero. */
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    mem_ndims = 0;
+    mem_dims[mem_ndims++] = dims[0];
+    len = dims[0];
+    for (i = 0; i < npd; i++) {
+        mem_dims[npd - i] = count[i] + 2 * nghost;
+        len *= mem_dims[npd - i];
+    }
+    mem_ndims += npd;
+    if (!_use_complex_type(scalarfield)) {
+        mem_dims[mem_ndims++] = dims[ndims - 1];
+        len *= dims[ndims - 1];
+    }
+    memset(buf, 0, sizeof(double) * len * ((_use_complex_type(scalarfield)) ? 2 : 1));
+
+    for (i = 0; i < npd; i++) {
+        seg[i] = malloc(sizeof(hsize_t) * 3 *
+                        ((count[i] + 2 * nghost) / scalarfield->number_of_grid_points[i] + 2));
+        nseg[i] = _get_halo_segments(scalarfield->number_of_grid_points[i],
+                                     scalarfield->cell.dimension_types[i] == ESCDF_DIRECTION_PERIODIC,
+                                     start[i], count[i], nghost, seg[i]);
+        iseg[i] = 0;
+    }
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        err = loc_id;
+        goto cleanup_seg;
+    }
+    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        goto cleanup_seg;
+    }
+    if ((type_id = _create_mem_type(scalarfield, H5T_NATIVE_DOUBLE)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        err = type_id;
+        goto cleanup_seg;
+    }
+
+    /* Read each combination of segments, up to 27 pieces in 3D, into
+       its place in the user buffer. Only the blocks on the cell
+       boundary wrap, so ranks issue different numbers of reads: they
+       all issue the largest one, the extra reads being empty, as
+       collective transfers require. */
+    nreads = 1;
+    for (i = 0; i < npd; i++) {
+        nreads *= nseg[i];
+    }
+    maxreads = nreads;
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        MPI_Allreduce(&nreads, &maxreads, 1, MPI_UNSIGNED, MPI_MAX, file_id->comm);
+    }
+#endif
+    err = ESCDF_SUCCESS;
+    done = false;
+    while (!done) {
+        empty = false;
+        mem_start[0] = 0;
+        mem_count[0] = mem_dims[0];
+        for (i = 0; i < npd; i++) {
+            pstart[i] = seg[i][iseg[i] * 3 + 0];
+            pcount[i] = seg[i][iseg[i] * 3 + 1];
+            mem_start[npd - i] = seg[i][iseg[i] * 3 + 2];
+            mem_count[npd - i] = pcount[i];
+            empty = empty || pcount[i] == 0;
+        }
+        if (mem_ndims > npd + 1) {
+            mem_start[npd + 1] = 0;
+            mem_count[npd + 1] = mem_dims[npd + 1];
+        }
+        if (!empty && err == ESCDF_SUCCESS) {
+            nboxes = _get_grid_box_selection(scalarfield, pstart, pcount, &bstart, &bcount);
+            err = utils_hdf5_read_dataset_boxes_mem(dtset_id, file_id->transfer_mode,
+                                                    buf, type_id, nboxes, bstart, bcount, NULL,
+                                                    mem_dims, mem_ndims, mem_start, mem_count, NULL);
+            free(bstart);
+            free(bcount);
+        } else {
+            utils_hdf5_read_dataset_boxes(dtset_id, file_id->transfer_mode,
+                                          buf, type_id, 0, NULL, NULL, NULL);
+        }
+        /* Next combination. */
+        done = true;
+        for (j = 0; j < npd && done; j++) {
+            iseg[j] += 1;
+            if (iseg[j] < nseg[j]) {
+                done = false;
+            } else {
+                iseg[j] = 0;
+            }
+        }
+    }
+    for (; nreads < maxreads; nreads++) {
+        utils_hdf5_read_dataset_boxes(dtset_id, file_id->transfer_mode,
+                                      buf, type_id, 0, NULL, NULL, NULL);
+    }
+
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+    H5Gclose(loc_id);
+
+ cleanup_seg:
+    for (i = 0; i < npd; i++) {
+        free(seg[i]);
+    }
+    return err;
+}
+
+/* Interpolation of values at arbitrary points. The points are
+   processed by batches, sorted by the chunk holding their stencil, and
+   the needed grid points of a batch are fetched in a single point
+   selection, also sorted by chunk. */
+#define MAX_INTERP_BATCH_SIZE 4096
+
+typedef struct {
+    hsize_t key;
+    hsize_t index;
+} _key_index_t;
+
+static int _compare_key_index(const void *a, const void *b)
+{
+    hsize_t ka = ((const _key_index_t*)a)->key;
+    hsize_t kb = ((const _key_index_t*)b)->key;
+
+    return (ka > kb) - (ka < kb);
+}
+
+/* A key that orders grid points chunk by chunk, as stored on disk. */
+static hsize_t _get_chunk_key(const _chunk_key_t *ck, hsize_t ipoint)
+{
+    hsize_t g[3], cidx, off, vol;
+    unsigned int i;
+
+    if (!ck->grid_layout) {
+        return ipoint;
+    }
+    for (i = 0; i < ck->npd; i++) {
+        g[i] = ipoint % ck->n[i];
+        ipoint /= ck->n[i];
+    }
+    cidx = 0;
+    off = 0;
+    vol = 1;
+    for (i = ck->npd; i > 0; i--) {
+        cidx = cidx * ck->nchunks[i - 1] + g[i - 1] / ck->chunk[i - 1];
+        off = off * ck->chunk[i - 1] + g[i - 1] % ck->chunk[i - 1];
+        vol *= ck->chunk[i - 1];
+    }
+    return cidx * vol + off;
+}
+
+/* Grid points and weights along each direction for the point r. Along
+   periodic directions the stencil wraps around, otherwise it is
+   clamped to the cell. Missing directions have a single point. */
+static void _get_stencil(const escdf_grid_scalarfield_t *scalarfield,
+                         double inv[3][3], const double *r, unsigned int order,
+                         hsize_t idx[3][4], double w[3][4])
+{
+    unsigned int j, k, npd;
+    long long int n, i0, g;
+    double f, t;
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    for (j = 0; j < 3; j++) {
+        for (k = 0; k < 4; k++) {
+            idx[j][k] = 0;
+            w[j][k] = 0.;
+        }
+        if (j >= npd) {
+            w[j][0] = 1.;
+            continue;
+        }
+        f = 0.;
+        for (k = 0; k < npd; k++) {
+            f += r[k] * inv[k][j];
+        }
+        n = scalarfield->number_of_grid_points[j];
+        i0 = (long long int)floor(f * n);
+        t = f * n - i0;
+        if (order == 2) {
+            w[j][0] = 1. - t;
+            w[j][1] = t;
+        } else {
+            /* Catmull-Rom cubic convolution. */
+            w[j][0] = 0.5 * (-t * t * t + 2. * t * t - t);
+            w[j][1] = 0.5 * (3. * t * t * t - 5. * t * t + 2.);
+            w[j][2] = 0.5 * (-3. * t * t * t + 4. * t * t + t);
+            w[j][3] = 0.5 * (t * t * t - t * t);
+            i0 -= 1;
+        }
+        for (k = 0; k < order; k++) {
+            g = i0 + k;
+            if (scalarfield->cell.dimension_types[j] == ESCDF_DIRECTION_PERIODIC) {
+                g = ((g % n) + n) % n;
+            } else {
+                g = (g < 0) ? 0 : (g >= n) ? n - 1 : g;
+            }
+            idx[j][k] = g;
+        }
+    }
+}
+
+escdf_errno_t escdf_grid_scalarfield_interpolate(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 escdf_interpolation_method method,
+                                                 size_t num_points,
+                                                 const double *points,
+                                                 double *values)
+{
+    escdf_errno_t err;
+    hid_t loc_id;
+    double inv[3][3], w[3][4], weight, *out, *vals;
+    hsize_t idx[3][4], n[3], ipoint;
+    _chunk_key_t ck;
+    _key_index_t *perm, *needed, key, *found;
+    unsigned int *g2d, *indirect;
+    unsigned int order, npd, nvalues, ncomp, i, x, y, z, c, v, o[3];
+    size_t ip, ib, nb, m, nu, b0, nreads, maxbatches;
+    escdf_handle_t tmp;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->cell.dimension_types, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->cell.lattice_vectors, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(method == ESCDF_INTERPOLATION_LINEAR ||
+                      method == ESCDF_INTERPOLATION_CUBIC, ESCDF_ERANGE);
+    FULFILL_OR_RETURN(num_points == 0 || (points && values), ESCDF_EVALUE);
+
+    if ((err = _get_inverse_lattice(scalarfield, inv)) != ESCDF_SUCCESS) {
+        return err;
+    }
+
+    /* Ranks have different numbers of points, hence of batches. They
+       agree on the largest count and pad with empty reads, so that the
+       datasets are opened the same number of times everywhere, and the
+       points are read with independent transfers. */
+    maxbatches = (num_points + MAX_INTERP_BATCH_SIZE - 1) / MAX_INTERP_BATCH_SIZE;
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        unsigned long lbatches = maxbatches, gbatches;
+
+        FULFILL_OR_RETURN(MPI_Allreduce(&lbatches, &gbatches, 1, MPI_UNSIGNED_LONG,
+                                        MPI_MAX, file_id->comm) == MPI_SUCCESS, ESCDF_ERROR);
+        maxbatches = gbatches;
+    }
+#endif
+    if (maxbatches == 0) {
+        return ESCDF_SUCCESS;
+    }
+
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    ncomp = scalarfield->number_of_components.value;
+    nvalues = scalarfield->real_or_complex.value;
+    order = (method == ESCDF_INTERPOLATION_CUBIC) ? 4 : 2;
+    for (i = 0; i < 3; i++) {
+        n[i] = (i < npd) ? scalarfield->number_of_grid_points[i] : 1;
+        o[i] = (i < npd) ? order : 1;
+    }
+    _init_chunk_key(scalarfield, &ck);
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    if ((err = _get_g2d(scalarfield, loc_id, &g2d)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    tmp = *file_id;
+    if ((tmp.transfer_mode = escdf_transfer_create(ESCDF_TRANSFER_INDEPENDENT)) < 0) {
+        free(g2d);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(tmp.transfer_mode);
+    }
+
+    /* Sort the points by the chunk of the first point of their stencil. */
+    perm = malloc(sizeof(_key_index_t) * num_points);
+    for (ip = 0; ip < num_points; ip++) {
+        _get_stencil(scalarfield, inv, points + ip * npd, order, idx, w);
+        ipoint = idx[0][0] + n[0] * (idx[1][0] + n[1] * idx[2][0]);
+        perm[ip].key = _get_chunk_key(&ck, (g2d) ? g2d[ipoint] : ipoint);
+        perm[ip].index = ip;
+    }
+    qsort(perm, num_points, sizeof(_key_index_t), _compare_key_index);
+
+    needed = malloc(sizeof(_key_index_t) * MAX_INTERP_BATCH_SIZE * o[0] * o[1] * o[2]);
+    indirect = malloc(sizeof(unsigned int) * MAX_INTERP_BATCH_SIZE * o[0] * o[1] * o[2]);
+    vals = malloc(sizeof(double) * MAX_INTERP_BATCH_SIZE * o[0] * o[1] * o[2] * ncomp * nvalues);
+    err = ESCDF_SUCCESS;
+    nreads = 0;
+    for (b0 = 0; b0 < num_points && err == ESCDF_SUCCESS; b0 += MAX_INTERP_BATCH_SIZE) {
+        nb = (num_points - b0 < MAX_INTERP_BATCH_SIZE) ? num_points - b0 : MAX_INTERP_BATCH_SIZE;
+
+        /* Gather the unique grid points of all stencils of the batch. */
+        m = 0;
+        for (ib = 0; ib < nb; ib++) {
+            _get_stencil(scalarfield, inv, points + perm[b0 + ib].index * npd, order, idx, w);
+            for (z = 0; z < o[2]; z++) {
+                for (y = 0; y < o[1]; y++) {
+                    for (x = 0; x < o[0]; x++) {
+                        ipoint = idx[0][x] + n[0] * (idx[1][y] + n[1] * idx[2][z]);
+                        if (g2d) {
+                            ipoint = g2d[ipoint];
+                        }
+                        needed[m].key = _get_chunk_key(&ck, ipoint);
+                        needed[m].index = ipoint;
+                        m += 1;
+                    }
+                }
+            }
+        }
+        qsort(needed, m, sizeof(_key_index_t), _compare_key_index);
+        nu = 0;
+        for (i = 0; i < m; i++) {
+            if (nu == 0 || needed[i].key != needed[nu - 1].key) {
+                needed[nu++] = needed[i];
+            }
+        }
+        for (i = 0; i < nu; i++) {
+            indirect[i] = needed[i].index;
+        }
+        if ((err = _read_at(scalarfield, &tmp, loc_id, vals, H5T_NATIVE_DOUBLE,
+                            indirect, nu)) != ESCDF_SUCCESS) {
+            break;
+        }
+        nreads += 1;
+
+        /* Accumulate the weighted values. */
+        for (ib = 0; ib < nb; ib++) {
+            _get_stencil(scalarfield, inv, points + perm[b0 + ib].index * npd, order, idx, w);
+            out = values + perm[b0 + ib].index * ncomp * nvalues;
+            for (i = 0; i < ncomp * nvalues; i++) {
+                out[i] = 0.;
+            }
+            for (z = 0; z < o[2]; z++) {
+                for (y = 0; y < o[1]; y++) {
+                    for (x = 0; x < o[0]; x++) {
+                        weight = w[0][x] * w[1][y] * w[2][z];
+                        ipoint = idx[0][x] + n[0] * (idx[1][y] + n[1] * idx[2][z]);
+                        key.key = _get_chunk_key(&ck, (g2d) ? g2d[ipoint] : ipoint);
+                        found = bsearch(&key, needed, nu, sizeof(_key_index_t), _compare_key_index);
+                        for (c = 0; c < ncomp; c++) {
+                            for (v = 0; v < nvalues; v++) {
+                                out[c * nvalues + v] +=
+                                    weight * vals[(c * nu + (found - needed)) * nvalues + v];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    /* Empty reads for the batches of the other ranks, also after an
+       error here. */
+    for (; nreads < maxbatches; nreads++) {
+        if (_read_at(scalarfield, &tmp, loc_id, vals, H5T_NATIVE_DOUBLE,
+                     indirect, 0) != ESCDF_SUCCESS && err == ESCDF_SUCCESS) {
+            err = ESCDF_ERROR;
+        }
+    }
+
+    if (tmp.transfer_mode != H5P_DEFAULT) {
+        H5Pclose(tmp.transfer_mode);
+    }
+    free(vals);
+    free(indirect);
+    free(needed);
+    free(perm);
+    free(g2d);
+    H5Gclose(loc_id);
+    return err;
+}
+
+escdf_errno_t escdf_grid_scalarfield_write_levels(const escdf_grid_scalarfield_t *scalarfield,
+                                                  escdf_handle_t *file_id)
+{
+    escdf_errno_t err;
+    hid_t loc_id;
+    hsize_t start[3], count[3], len;
+    unsigned int i;
+    double *buf;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+
+    if (!scalarfield->number_of_levels.is_set || scalarfield->number_of_levels.value == 0) {
+        return ESCDF_SUCCESS;
+    }
+
+    /* Read back the full field in the default ordering. */
+    for (i = 0; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+        start[i] = 0;
+        count[i] = scalarfield->number_of_grid_points[i];
+    }
+    len = scalarfield->number_of_components.value * _get_number_of_points(scalarfield) *
+        scalarfield->real_or_complex.value;
+    buf = malloc(sizeof(double) * len);
+    if ((err = _read_values_on_grid_box(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                        start, count)) != ESCDF_SUCCESS) {
+        free(buf);
+        return err;
+    }
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        free(buf);
+        RETURN_WITH_ERROR(loc_id);
+    }
+    err = _write_levels(scalarfield, file_id, loc_id, buf);
+    free(buf);
+    H5Gclose(loc_id);
+    return err;
+}
+
+escdf_errno_t escdf_grid_scalarfield_read_statistics(const escdf_grid_scalarfield_t *scalarfield,
+                                                     escdf_handle_t *file_id,
+                                                     double *minimum,
+                                                     double *maximum,
+                                                     double *sum,
+                                                     double *integral)
+{
+    escdf_errno_t err;
+    hid_t loc_id;
+    size_t dims[2];
+    const char *names[4] = {"values_on_grid_minimum", "values_on_grid_maximum",
+                            "values_on_grid_sum", "values_on_grid_integral"};
+    double *bufs[4];
+    unsigned int i;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    dims[0] = scalarfield->number_of_components.value;
+    dims[1] = scalarfield->real_or_complex.value;
+    bufs[0] = minimum;
+    bufs[1] = maximum;
+    bufs[2] = sum;
+    bufs[3] = integral;
+    err = ESCDF_SUCCESS;
+    for (i = 0; i < 4 && err == ESCDF_SUCCESS; i++) {
+        if (bufs[i]) {
+            err = utils_hdf5_read_attr(loc_id, names[i], H5T_NATIVE_DOUBLE, dims, 2, bufs[i]);
+        }
+    }
+    H5Gclose(loc_id);
+    return err;
+}
+
+escdf_errno_t escdf_grid_scalarfield_read_chunk_statistics(const escdf_grid_scalarfield_t *scalarfield,
+                                                           escdf_handle_t *file_id,
+                                                           double *minimum,
+                                                           double *maximum)
+{
+    escdf_errno_t err;
+    hid_t loc_id, dtset_id;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    unsigned int ndims;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->use_chunk_statistics.is_set &&
+                      scalarfield->use_chunk_statistics.value, ESCDF_EUNINIT);
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    ndims = _get_chunk_statistics_dims(scalarfield, dims);
+    err = ESCDF_SUCCESS;
+    if (minimum &&
+        (err = utils_hdf5_check_dataset(loc_id, "values_on_grid_chunk_minimum",
+                                        dims, ndims, &dtset_id)) == ESCDF_SUCCESS) {
+        err = utils_hdf5_read_dataset(dtset_id, file_id->transfer_mode, minimum,
+                                      H5T_NATIVE_DOUBLE, NULL, NULL, NULL);
+        H5Dclose(dtset_id);
+    }
+    if (maximum && err == ESCDF_SUCCESS &&
+        (err = utils_hdf5_check_dataset(loc_id, "values_on_grid_chunk_maximum",
+                                        dims, ndims, &dtset_id)) == ESCDF_SUCCESS) {
+        err = utils_hdf5_read_dataset(dtset_id, file_id->transfer_mode, maximum,
+                                      H5T_NATIVE_DOUBLE, NULL, NULL, NULL);
+        H5Dclose(dtset_id);
+    }
+    H5Gclose(loc_id);
+    return err;
+}
+
+/* Open values_on_grid_frames and check that each frame is consistent
+   with the metadata in scalarfield. The keyframe interval is the one
+   stored with the dataset, whatever is set in scalarfield. */
+static escdf_errno_t _get_values_on_grid_frames(const escdf_grid_scalarfield_t *scalarfield,
+                                                hid_t loc_id, hid_t *dtset_id,
+                                                size_t *nframes,
+                                                unsigned int *interval)
+{
+    escdf_errno_t err;
+    hid_t dtspace_id;
+    size_t bounds[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t dims[MAX_VALUES_ON_GRID_NDIMS + 1];
+    unsigned int i, ndims;
+    bool has_frames;
+
+    if ((err = utils_hdf5_open_dataset(loc_id, "values_on_grid_frames",
+                                       dtset_id)) != ESCDF_SUCCESS) {
+        return err;
+    }
+    if ((err = utils_hdf5_get_frames(*dtset_id, &has_frames, nframes)) != ESCDF_SUCCESS) {
+        H5Dclose(*dtset_id);
+        return err;
+    }
+    ndims = _get_values_on_grid_dims(scalarfield, bounds);
+    if ((dtspace_id = H5Dget_space(*dtset_id)) < 0) {
+        H5Dclose(*dtset_id);
+        RETURN_WITH_ERROR(dtspace_id);
+    }
+    if (!has_frames || H5Sget_simple_extent_ndims(dtspace_id) != (int)ndims + 1) {
+        H5Sclose(dtspace_id);
+        H5Dclose(*dtset_id);
+        RETURN_WITH_ERROR(ESCDF_ESIZE);
+    }
+    H5Sget_simple_extent_dims(dtspace_id, dims, NULL);
+    H5Sclose(dtspace_id);
+    for (i = 0; i < ndims; i++) {
+        if (dims[i + 1] != bounds[i]) {
+            H5Dclose(*dtset_id);
+            RETURN_WITH_ERROR(ESCDF_ESIZE);
+        }
+    }
+    *interval = 0;
+    if (utils_hdf5_check_present_attr(*dtset_id, "keyframe_interval") &&
+        (err = utils_hdf5_read_attr(*dtset_id, "keyframe_interval", H5T_NATIVE_UINT,
+                                    NULL, 0, interval)) != ESCDF_SUCCESS) {
+        H5Dclose(*dtset_id);
+        return err;
+    }
+    return ESCDF_SUCCESS;
+}
+
+static bool _is_keyframe(size_t frame, unsigned int interval)
+{
+    return interval <= 1 || frame % interval == 0;
+}
+
+/* The number of elements of one frame. */
+static size_t _get_frame_size(const escdf_grid_scalarfield_t *scalarfield)
+{
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    unsigned int i, ndims;
+    size_t len;
+
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    len = 1;
+    for (i = 0; i < ndims; i++) {
+        len *= dims[i];
+    }
+    return len;
+}
+
+static escdf_errno_t _read_frame(const escdf_grid_scalarfield_t *scalarfield,
+                                 hid_t dtset_id, hid_t xfer_id, size_t frame,
+                                 void *buf, hid_t mem_type_id)
+{
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    size_t start[MAX_VALUES_ON_GRID_NDIMS + 1], count[MAX_VALUES_ON_GRID_NDIMS + 1];
+    unsigned int i, ndims;
+
+    ndims = _get_values_on_grid_dims(scalarfield, dims);
+    start[0] = frame;
+    count[0] = 1;
+    for (i = 0; i < ndims; i++) {
+        start[i + 1] = 0;
+        count[i + 1] = dims[i];
+    }
+    return utils_hdf5_read_dataset(dtset_id, xfer_id, buf, mem_type_id, start, count, NULL);
+}
+
+/* Rebuild the disk representation of a frame from its keyframe and
+   its delta. buf and work hold one frame of disk_type_id. */
+static escdf_errno_t _read_frame_delta(const escdf_grid_scalarfield_t *scalarfield,
+                                       hid_t dtset_id, hid_t xfer_id,
+                                       size_t frame, unsigned int interval,
+                                       hid_t disk_type_id,
+                                       unsigned char *buf, unsigned char *work)
+{
+    escdf_errno_t err;
+    size_t i, len;
+
+    if ((err = _read_frame(scalarfield, dtset_id, xfer_id, frame - frame % interval,
+                           buf, disk_type_id)) != ESCDF_SUCCESS) {
+        return err;
+    }
+    if ((err = _read_frame(scalarfield, dtset_id, xfer_id, frame,
+                           work, disk_type_id)) != ESCDF_SUCCESS) {
+        return err;
+    }
+    len = _get_frame_size(scalarfield) * H5Tget_size(disk_type_id);
+    for (i = 0; i < len; i++) {
+        buf[i] ^= work[i];
+    }
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_get_number_of_frames(const escdf_grid_scalarfield_t *scalarfield,
+                                                          escdf_handle_t *file_id,
+                                                          size_t *number_of_frames)
+{
+    escdf_errno_t err;
+    hid_t loc_id, dtset_id;
+    unsigned int interval;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(number_of_frames, ESCDF_EVALUE);
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    err = _get_values_on_grid_frames(scalarfield, loc_id, &dtset_id,
+                                     number_of_frames, &interval);
+    if (err == ESCDF_SUCCESS) {
+        H5Dclose(dtset_id);
+    }
+    H5Gclose(loc_id);
+    return err;
+}
+
+/* Convert one frame of buf into its disk representation and XOR it
+   with its keyframe, read from the file. */
+static escdf_errno_t _encode_frame_delta(const escdf_grid_scalarfield_t *scalarfield,
+                                         hid_t dtset_id, hid_t xfer_id,
+                                         size_t frame, unsigned int interval,
+                                         const void *buf, hid_t mem_type_id,
+                                         hid_t disk_type_id, unsigned char **delta)
+{
+    escdf_errno_t err;
+    unsigned char *key;
+    size_t i, len, mem_size, disk_size;
+
+    len = _get_frame_size(scalarfield);
+    mem_size = H5Tget_size(mem_type_id);
+    disk_size = H5Tget_size(disk_type_id);
+    *delta = malloc(len * ((mem_size > disk_size) ? mem_size : disk_size));
+    memcpy(*delta, buf, len * mem_size);
+    if (H5Tconvert(mem_type_id, disk_type_id, len, *delta, NULL, H5P_DEFAULT) < 0) {
+        free(*delta);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    key = malloc(len * disk_size);
+    if ((err = _read_frame(scalarfield, dtset_id, xfer_id, frame - frame % interval,
+                           key, disk_type_id)) != ESCDF_SUCCESS) {
+        free(key);
+        free(*delta);
+        return err;
+    }
+    for (i = 0; i < len * disk_size; i++) {
+        (*delta)[i] ^= key[i];
+    }
+    free(key);
+    return ESCDF_SUCCESS;
+}
+
+static escdf_errno_t _append_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                            escdf_handle_t *file_id,
+                                            const void *buf, hid_t mem_type_id,
+                                            const unsigned int *tbl,
+                                            size_t *frame)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id, disk_type_id;
+    size_t nframes;
+    unsigned int interval;
+    unsigned char *delta;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->use_default_ordering.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(!tbl || !scalarfield->use_default_ordering.value, ESCDF_EUNINIT);
+
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    if ((err = _get_values_on_grid_frames(scalarfield, loc_id, &dtset_id,
+                                          &nframes, &interval)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    /* The lookup table is shared by all frames and given with the first one. */
+    if (nframes == 0 && !scalarfield->use_default_ordering.value && !tbl) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(ESCDF_EUNINIT);
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    if (_is_keyframe(nframes, interval)) {
+        err = utils_hdf5_append_frame(dtset_id, file_id->transfer_mode, buf, type_id, frame);
+    } else if ((disk_type_id = _create_disk_type(scalarfield)) < 0) {
+        err = disk_type_id;
+    } else {
+        err = _encode_frame_delta(scalarfield, dtset_id, file_id->transfer_mode,
+                                  nframes, interval, buf, type_id, disk_type_id, &delta);
+        if (err == ESCDF_SUCCESS) {
+            err = utils_hdf5_append_frame(dtset_id, file_id->transfer_mode,
+                                          delta, disk_type_id, frame);
+            free(delta);
+        }
+        H5Tclose(disk_type_id);
+    }
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+    if (err == ESCDF_SUCCESS && nframes == 0 && tbl != NULL) {
+        err = _write_grid_ordering(scalarfield, file_id, loc_id, tbl, NULL, NULL, NULL);
+    }
+    H5Gclose(loc_id);
+    return err;
+}
+
+escdf_errno_t escdf_grid_scalarfield_append_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                                           escdf_handle_t *file_id,
+                                                           const double *buf,
+                                                           const unsigned int *tbl,
+                                                           size_t *frame)
+{
+    return _append_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE, tbl, frame);
+}
+escdf_errno_t escdf_grid_scalarfield_append_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                 escdf_handle_t *file_id,
+                                                                 const float *buf,
+                                                                 const unsigned int *tbl,
+                                                                 size_t *frame)
+{
+    return _append_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_FLOAT, tbl, frame);
+}
+
+static escdf_errno_t _read_values_on_grid_frame(const escdf_grid_scalarfield_t *scalarfield,
+                                                escdf_handle_t *file_id,
+                                                size_t frame,
+                                                void *buf, hid_t mem_type_id)
+{
+    escdf_errno_t err;
+    hid_t dtset_id, loc_id, type_id, disk_type_id;
+    size_t nframes, len, mem_size, disk_size;
+    unsigned int interval;
+    unsigned char *raw, *work;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
     FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
 
-    start[0] = 0;
-    start[1] = 0;
-    start[2] = 0;
-    count[0] = scalarfield->number_of_components.value;
-    count[1] = len;
-    count[2] = scalarfield->real_or_complex.value;
-
-    /* Modify the start[1] value from the gather of len. */
-    err = _get_proc_grid_offset(&start[1], file_id,
-                                scalarfield->cell.number_of_physical_dimensions.value,
-                                scalarfield->number_of_grid_points, len);
-    FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    if ((err = _get_values_on_grid_frames(scalarfield, loc_id, &dtset_id,
+                                          &nframes, &interval)) != ESCDF_SUCCESS) {
+        H5Gclose(loc_id);
+        return err;
+    }
+    if (frame >= nframes) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(ESCDF_ERANGE);
+    }
+    if ((type_id = _create_mem_type(scalarfield, mem_type_id)) < 0) {
+        H5Dclose(dtset_id);
+        H5Gclose(loc_id);
+        RETURN_WITH_ERROR(type_id);
+    }
+    if (_is_keyframe(frame, interval)) {
+        err = _read_frame(scalarfield, dtset_id, file_id->transfer_mode,
+                          frame, buf, type_id);
+    } else if ((disk_type_id = _create_disk_type(scalarfield)) < 0) {
+        err = disk_type_id;
+    } else {
+        /* Only the keyframe and the delta are read. */
+        len = _get_frame_size(scalarfield);
+        mem_size = H5Tget_size(type_id);
+        disk_size = H5Tget_size(disk_type_id);
+        raw = malloc(len * ((mem_size > disk_size) ? mem_size : disk_size));
+        work = malloc(len * disk_size);
+        err = _read_frame_delta(scalarfield, dtset_id, file_id->transfer_mode,
+                                frame, interval, disk_type_id, raw, work);
+        if (err == ESCDF_SUCCESS &&
+            H5Tconvert(disk_type_id, type_id, len, raw, NULL, H5P_DEFAULT) < 0) {
+            err = ESCDF_ERROR;
+        }
+        if (err == ESCDF_SUCCESS) {
+            memcpy(buf, raw, len * mem_size);
+        }
+        free(work);
+        free(raw);
+        H5Tclose(disk_type_id);
+    }
+    H5Tclose(type_id);
+    H5Dclose(dtset_id);
+    H5Gclose(loc_id);
+    return err;
+}
 
-    return escdf_grid_scalarfield_write_values_on_grid
-        (scalarfield, file_id, buf, tbl, start, count, NULL);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_frame(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id,
+                                                               size_t frame,
+                                                               double *buf)
+{
+    return _read_values_on_grid_frame(scalarfield, file_id, frame, buf, H5T_NATIVE_DOUBLE);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_frame_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                     escdf_handle_t *file_id,
+                                                                     size_t frame,
+                                                                     float *buf)
+{
+    return _read_values_on_grid_frame(scalarfield, file_id, frame, buf, H5T_NATIVE_FLOAT);
 }
 
-escdf_errno_t escdf_grid_scalarfield_read_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
-                                                         escdf_handle_t *file_id, double *buf,
-                                                         const hsize_t *start,
-                                                         const hsize_t *count,
-                                                         const hsize_t *stride)
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_level(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id,
+                                                               unsigned int level,
+                                                               double *buf)
 {
     escdf_errno_t err;
-    hid_t dtset_id, loc_id;
+    hid_t loc_id, dtset_id, type_id;
+    size_t dims[MAX_VALUES_ON_GRID_NDIMS];
+    hsize_t start[3], count[3];
+    unsigned int i, ndims;
+    char name[32];
 
     FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
     FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
-    
+    FULFILL_OR_RETURN(level <= escdf_grid_scalarfield_get_number_of_levels(scalarfield), ESCDF_ERANGE);
+
+    if (level == 0) {
+        for (i = 0; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+            start[i] = 0;
+            count[i] = scalarfield->number_of_grid_points[i];
+        }
+        return _read_values_on_grid_box(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                        start, count);
+    }
+
     if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
         RETURN_WITH_ERROR(loc_id);
     }
-    
-    if ((err = _get_values_on_grid(scalarfield, loc_id, &dtset_id)) != ESCDF_SUCCESS) {
+    _get_level_name(level, name);
+    ndims = _get_level_dims(scalarfield, level, dims);
+    if ((err = utils_hdf5_check_dataset(loc_id, name, dims, ndims, &dtset_id)) != ESCDF_SUCCESS) {
         H5Gclose(loc_id);
         return err;
     }
-    if ((err = utils_hdf5_read_dataset(dtset_id, file_id->transfer_mode,
-                                       buf, H5T_NATIVE_DOUBLE,
-                                       start, count, stride)) != ESCDF_SUCCESS) {
+    if ((type_id = _create_mem_type(scalarfield, H5T_NATIVE_DOUBLE)) < 0) {
         H5Dclose(dtset_id);
         H5Gclose(loc_id);
-        return err;
+        RETURN_WITH_ERROR(type_id);
     }
-
+    err = utils_hdf5_read_dataset(dtset_id, file_id->transfer_mode,
+                                  buf, type_id, NULL, NULL, NULL);
+    H5Tclose(type_id);
     H5Dclose(dtset_id);
     H5Gclose(loc_id);
-    return ESCDF_SUCCESS;
+    return err;
 }
-escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
-                                                                escdf_handle_t *file_id,
-                                                                double *buf,
-                                                                const unsigned int *tbl,
-                                                                const hsize_t len)
+
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                                         escdf_handle_t *file_id, double *buf,
+                                                         const hsize_t *start,
+                                                         const hsize_t *count,
+                                                         const hsize_t *stride)
+{
+    return _read_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                start, count, stride, NULL, 0, NULL, NULL, NULL);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id, float *buf,
+                                                               const hsize_t *start,
+                                                               const hsize_t *count,
+                                                               const hsize_t *stride)
+{
+    return _read_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                start, count, stride, NULL, 0, NULL, NULL, NULL);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_mem(const escdf_grid_scalarfield_t *scalarfield,
+                                                             escdf_handle_t *file_id, double *buf,
+                                                             const hsize_t *start,
+                                                             const hsize_t *count,
+                                                             const hsize_t *stride,
+                                                             const hsize_t *mem_dims,
+                                                             unsigned int mem_ndims,
+                                                             const hsize_t *mem_start,
+                                                             const hsize_t *mem_count,
+                                                             const hsize_t *mem_stride)
+{
+    return _read_values_on_grid(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                start, count, stride,
+                                mem_dims, mem_ndims, mem_start, mem_count, mem_stride);
+}
+/* Read the values of the range [offset, offset + len[ of grid points
+   in the storage ordering, in a single transfer whatever the layout. */
+static escdf_errno_t _read_values_on_grid_range(const escdf_grid_scalarfield_t *scalarfield,
+                                                escdf_handle_t *file_id,
+                                                void *buf, hid_t mem_type_id,
+                                                hsize_t offset, hsize_t len)
+{
+    hsize_t start[3], count[3];
+    hsize_t bstart[5 * MAX_VALUES_ON_GRID_NDIMS], bcount[5 * MAX_VALUES_ON_GRID_NDIMS];
+    size_t nboxes;
+
+    if (_use_grid_layout(scalarfield)) {
+        /* With the grid layout, a slice is a union of boxes. */
+        nboxes = _get_range_boxes(scalarfield, offset, len, bstart, bcount);
+        return _read_values_on_grid_boxes(scalarfield, file_id, buf, mem_type_id,
+                                          nboxes, bstart, bcount);
+    }
+
+    start[0] = 0;
+    start[1] = offset;
+    start[2] = 0;
+    count[0] = scalarfield->number_of_components.value;
+    count[1] = len;
+    count[2] = scalarfield->real_or_complex.value;
+    return _read_values_on_grid(scalarfield, file_id, buf, mem_type_id,
+                                start, count, NULL, NULL, 0, NULL, NULL, NULL);
+}
+
+static escdf_errno_t _read_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 void *buf, hid_t mem_type_id,
+                                                 const unsigned int *tbl,
+                                                 const hsize_t *offset,
+                                                 const hsize_t len)
 {
     escdf_errno_t err;
     hid_t loc_id;
     hsize_t goffset;
     unsigned int i;
-    hsize_t start[3], count[3];
 
     unsigned int *g2d, *indirect;
 
@@ -871,7 +3860,7 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
         }
         free(g2d);
         if ((err = _read_at(scalarfield, file_id, loc_id,
-                            buf, indirect, len)) != ESCDF_SUCCESS) {
+                            buf, mem_type_id, indirect, len)) != ESCDF_SUCCESS) {
             free(indirect);
             H5Gclose(loc_id);
             return err;
@@ -881,17 +3870,19 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
         /* Case where ask for a disordered subset of points in an
            ordered storage. */
         if ((err = _read_at(scalarfield, file_id, loc_id,
-                            buf, tbl, len)) != ESCDF_SUCCESS) {
+                            buf, mem_type_id, tbl, len)) != ESCDF_SUCCESS) {
             H5Gclose(loc_id);
             return err;
         }
     } else if (!tbl && g2d) {
         /* Case where ask for an ordered subset of points in a
            disordered storage. */
-        if ((err = _get_proc_grid_offset(&goffset, file_id,
-                                         scalarfield->cell.number_of_physical_dimensions.value,
-                                         scalarfield->number_of_grid_points,
-                                         len)) != ESCDF_SUCCESS) {
+        if (offset) {
+            goffset = *offset;
+        } else if ((err = _get_proc_grid_offset(&goffset, file_id,
+                                                scalarfield->cell.number_of_physical_dimensions.value,
+                                                scalarfield->number_of_grid_points,
+                                                len)) != ESCDF_SUCCESS) {
             free(g2d);
             H5Gclose(loc_id);
             return err;
@@ -904,7 +3895,7 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
         free(g2d);
 
         if ((err = _read_at(scalarfield, file_id, loc_id,
-                            buf, indirect, len)) != ESCDF_SUCCESS) {
+                            buf, mem_type_id, indirect, len)) != ESCDF_SUCCESS) {
             free(indirect);
             H5Gclose(loc_id);
             return err;
@@ -913,22 +3904,17 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
     } else { /* !tbl && !g2d */
         /* Case where ask for an ordered subset of points in an
            ordered storage. */
-        start[0] = 0;
-        start[1] = 0;
-        start[2] = 0;
-        count[0] = scalarfield->number_of_components.value;
-        count[1] = len;
-        count[2] = scalarfield->real_or_complex.value;
-
-        if ((err = _get_proc_grid_offset
-             (&start[1], file_id, scalarfield->cell.number_of_physical_dimensions.value,
+        if (offset) {
+            goffset = *offset;
+        } else if ((err = _get_proc_grid_offset
+             (&goffset, file_id, scalarfield->cell.number_of_physical_dimensions.value,
               scalarfield->number_of_grid_points, len)) != ESCDF_SUCCESS) {
             H5Gclose(loc_id);
             return err;
         }
 
-        if ((err = escdf_grid_scalarfield_read_values_on_grid
-             (scalarfield, file_id, buf, start, count, NULL)) != ESCDF_SUCCESS) {
+        if ((err = _read_values_on_grid_range(scalarfield, file_id, buf, mem_type_id,
+                                              goffset, len)) != ESCDF_SUCCESS) {
             H5Gclose(loc_id);
             return err;
         }
@@ -937,6 +3923,220 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
     H5Gclose(loc_id);
     return ESCDF_SUCCESS;
 }
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid_scalarfield_t *scalarfield,
+                                                                escdf_handle_t *file_id,
+                                                                double *buf,
+                                                                const unsigned int *tbl,
+                                                                const hsize_t len)
+{
+    return _read_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                       tbl, NULL, len);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                   escdf_handle_t *file_id,
+                                                                   double *buf,
+                                                                   const unsigned int *tbl,
+                                                                   const hsize_t offset,
+                                                                   const hsize_t len)
+{
+    return _read_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                       tbl, &offset, len);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                      escdf_handle_t *file_id,
+                                                                      float *buf,
+                                                                      const unsigned int *tbl,
+                                                                      const hsize_t len)
+{
+    return _read_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                       tbl, NULL, len);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_float_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                         escdf_handle_t *file_id,
+                                                                         float *buf,
+                                                                         const unsigned int *tbl,
+                                                                         const hsize_t offset,
+                                                                         const hsize_t len)
+{
+    return _read_values_on_grid_sliced(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                       tbl, &offset, len);
+}
+
+/**
+ * Same as _read_values_on_grid_sliced() for an arbitrary set of
+ * points given by @tbl, but done in two phases: each process first
+ * reads the contiguous block of _get_block_slice(), then
+ * the values are sent to the processes that requested them, with
+ * all-to-all exchanges. This is a collective call.
+ */
+static escdf_errno_t _read_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                        escdf_handle_t *file_id,
+                                                        void *buf, hid_t mem_type_id,
+                                                        const unsigned int *tbl,
+                                                        const hsize_t len)
+{
+    escdf_errno_t err;
+    hid_t loc_id;
+    unsigned long long int nbad, *reqs, *asked;
+    hsize_t npoints, offset, mylen, nasked, i, c, pos;
+    size_t ncomp, nval, val_size, rec_size;
+    int *sendcounts, *senddispls, *fill, dest;
+    unsigned int *g2d;
+    size_t *slot;
+    char *block, *replies, *answers;
+#ifdef HAVE_MPI
+    int *recvcounts = NULL, *recvdispls = NULL, p;
+    MPI_Datatype rec_type;
+#endif
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(scalarfield->cell.number_of_physical_dimensions.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_components.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->number_of_grid_points, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(scalarfield->real_or_complex.is_set, ESCDF_EUNINIT);
+    FULFILL_OR_RETURN(tbl || len == 0, ESCDF_EVALUE);
+
+    npoints = _get_number_of_points(scalarfield);
+
+    /* Agree on the validity of the requests before any exchange. */
+    nbad = 0;
+    for (i = 0; i < len; i++) {
+        if (tbl[i] >= npoints) {
+            nbad += 1;
+        }
+    }
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &nbad, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, file_id->comm);
+    }
+#endif
+    FULFILL_OR_RETURN(nbad == 0, ESCDF_ERANGE);
+
+    /* Requests are expressed as positions in the storage ordering. */
+    if ((loc_id = H5Gopen(file_id->group_id, scalarfield->path, H5P_DEFAULT)) < 0) {
+        RETURN_WITH_ERROR(loc_id);
+    }
+    err = _get_g2d(scalarfield, loc_id, &g2d);
+    H5Gclose(loc_id);
+    FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+
+    ncomp = scalarfield->number_of_components.value;
+    nval = scalarfield->real_or_complex.value;
+    val_size = nval * H5Tget_size(mem_type_id);
+    rec_size = ncomp * val_size;
+    _get_block_slice(npoints, file_id->mpi_size, file_id->mpi_rank, &offset, &mylen);
+
+    /* First phase, contiguous read of the owned range. */
+    block = malloc(mylen * rec_size + 1);
+    if ((err = _read_values_on_grid_range(scalarfield, file_id, block, mem_type_id,
+                                          offset, mylen)) != ESCDF_SUCCESS) {
+        free(block);
+        free(g2d);
+        return err;
+    }
+
+    /* Group the requested positions by owner, remembering where each
+       answer will be found. */
+    sendcounts = calloc(file_id->mpi_size, sizeof(int));
+    senddispls = malloc(sizeof(int) * file_id->mpi_size);
+    fill = malloc(sizeof(int) * file_id->mpi_size);
+    for (i = 0; i < len; i++) {
+        pos = (g2d) ? g2d[tbl[i]] : tbl[i];
+        sendcounts[_get_block_owner(npoints, file_id->mpi_size, pos)] += 1;
+    }
+    senddispls[0] = 0;
+    for (dest = 1; dest < file_id->mpi_size; dest++) {
+        senddispls[dest] = senddispls[dest - 1] + sendcounts[dest - 1];
+    }
+    memcpy(fill, senddispls, sizeof(int) * file_id->mpi_size);
+    reqs = malloc(sizeof(unsigned long long int) * len + 1);
+    slot = malloc(sizeof(size_t) * len + 1);
+    for (i = 0; i < len; i++) {
+        pos = (g2d) ? g2d[tbl[i]] : tbl[i];
+        dest = _get_block_owner(npoints, file_id->mpi_size, pos);
+        slot[i] = fill[dest];
+        reqs[fill[dest]++] = pos;
+    }
+    free(fill);
+    free(g2d);
+
+    asked = reqs;
+    nasked = len;
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        recvcounts = malloc(sizeof(int) * file_id->mpi_size);
+        recvdispls = malloc(sizeof(int) * file_id->mpi_size);
+        MPI_Alltoall(sendcounts, 1, MPI_INT, recvcounts, 1, MPI_INT, file_id->comm);
+        recvdispls[0] = 0;
+        for (p = 1; p < file_id->mpi_size; p++) {
+            recvdispls[p] = recvdispls[p - 1] + recvcounts[p - 1];
+        }
+        nasked = recvdispls[file_id->mpi_size - 1] + recvcounts[file_id->mpi_size - 1];
+        asked = malloc(sizeof(unsigned long long int) * nasked + 1);
+        MPI_Alltoallv(reqs, sendcounts, senddispls, MPI_UNSIGNED_LONG_LONG,
+                      asked, recvcounts, recvdispls, MPI_UNSIGNED_LONG_LONG, file_id->comm);
+    }
+#endif
+
+    /* Second phase, answer the requests from the owned range. */
+    answers = malloc(nasked * rec_size + 1);
+    for (i = 0; i < nasked; i++) {
+        for (c = 0; c < ncomp; c++) {
+            memcpy(answers + i * rec_size + c * val_size,
+                   block + (c * mylen + (asked[i] - offset)) * val_size, val_size);
+        }
+    }
+    free(block);
+
+    /* The answers follow the requests, with counts in records. */
+    replies = answers;
+#ifdef HAVE_MPI
+    if (file_id->mpi_size > 1) {
+        free(asked);
+        replies = malloc(len * rec_size + 1);
+        MPI_Type_contiguous((int)rec_size, MPI_BYTE, &rec_type);
+        MPI_Type_commit(&rec_type);
+        MPI_Alltoallv(answers, recvcounts, recvdispls, rec_type,
+                      replies, sendcounts, senddispls, rec_type, file_id->comm);
+        MPI_Type_free(&rec_type);
+        free(answers);
+        free(recvcounts);
+        free(recvdispls);
+    }
+#endif
+    free(reqs);
+    free(sendcounts);
+    free(senddispls);
+
+    for (i = 0; i < len; i++) {
+        for (c = 0; c < ncomp; c++) {
+            memcpy((char*)buf + (c * len + i) * val_size,
+                   replies + slot[i] * rec_size + c * val_size, val_size);
+        }
+    }
+    free(slot);
+    free(replies);
+
+    return ESCDF_SUCCESS;
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                                       escdf_handle_t *file_id,
+                                                                       double *buf,
+                                                                       const unsigned int *tbl,
+                                                                       const hsize_t len)
+{
+    return _read_values_on_grid_redistributed(scalarfield, file_id, buf, H5T_NATIVE_DOUBLE,
+                                              tbl, len);
+}
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_redistributed_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                             escdf_handle_t *file_id,
+                                                                             float *buf,
+                                                                             const unsigned int *tbl,
+                                                                             const hsize_t len)
+{
+    return _read_values_on_grid_redistributed(scalarfield, file_id, buf, H5T_NATIVE_FLOAT,
+                                              tbl, len);
+}
 
 /***************/
 /* IO streams. */
@@ -994,6 +4194,283 @@ escdf_errno_t escdf_grid_scalarfield_serialise(escdf_grid_scalarfield_t *scalarf
     if (scalarfield->grid_ordering_is_present) {
         fprintf(f, "  grid_ordering_is_present: yes\n");
     }
+    if (scalarfield->use_complex_type.is_set) {
+        fprintf(f, "  use_complex_type: %s\n",
+                (scalarfield->use_complex_type.value) ? "yes" : "no");
+    }
+    if (scalarfield->storage_precision.is_set) {
+        fprintf(f, "  storage_precision: %s\n",
+                (scalarfield->storage_precision.value == ESCDF_PRECISION_SINGLE) ? "single" : "double");
+    }
+    if (scalarfield->use_grid_layout.is_set) {
+        fprintf(f, "  use_grid_layout: %s\n",
+                (scalarfield->use_grid_layout.value) ? "yes" : "no");
+    }
+    if (scalarfield->number_of_levels.is_set) {
+        fprintf(f, "  number_of_levels: %d\n",
+                scalarfield->number_of_levels.value);
+    }
+    if (scalarfield->use_chunk_statistics.is_set) {
+        fprintf(f, "  use_chunk_statistics: %s\n",
+                (scalarfield->use_chunk_statistics.value) ? "yes" : "no");
+    }
+    if (scalarfield->use_time_series.is_set) {
+        fprintf(f, "  use_time_series: %s\n",
+                (scalarfield->use_time_series.value) ? "yes" : "no");
+    }
+    if (scalarfield->keyframe_interval.is_set) {
+        fprintf(f, "  keyframe_interval: %d\n",
+                scalarfield->keyframe_interval.value);
+    }
+    if (scalarfield->compression_level.is_set) {
+        fprintf(f, "  compression_level: %d\n",
+                scalarfield->compression_level.value);
+    }
+    if (scalarfield->grid_chunk_dims) {
+        fprintf(f, "  grid_chunk_dims: [ %d", scalarfield->grid_chunk_dims[0]);
+        for (i = 1; i < scalarfield->cell.number_of_physical_dimensions.value; i++) {
+            fprintf(f, ", %d", scalarfield->grid_chunk_dims[i]);
+        }
+        fprintf(f, "]\n");
+    }
+
+    return ESCDF_SUCCESS;
+}
+
+/* The binary form of a scalarfield, in native byte order: a magic
+   string, a byte order mark and a version, the path, a mask of the
+   set members, the scalar members, the arrays of the set members and
+   finally the number of values followed by the values, if any. Sizes
+   read from a stream are bounded before any allocation. */
+#define BINARY_MAGIC "ESCDFGSF"
+#define BINARY_BYTE_ORDER 0x01020304u
+#define BINARY_VERSION 2u
+#define BINARY_NUM_UINTS 7
+#define BINARY_NUM_BOOLS 5
+#define BINARY_MAX_PATH_LEN 65536u
+#define BINARY_DIMENSION_TYPES (1u << (BINARY_NUM_UINTS + BINARY_NUM_BOOLS))
+#define BINARY_LATTICE_VECTORS (BINARY_DIMENSION_TYPES << 1)
+#define BINARY_NUMBER_OF_GRID_POINTS (BINARY_DIMENSION_TYPES << 2)
+#define BINARY_GRID_CHUNK_DIMS (BINARY_DIMENSION_TYPES << 3)
+#define BINARY_VALUES_ON_GRID_IS_PRESENT (BINARY_DIMENSION_TYPES << 4)
+#define BINARY_GRID_ORDERING_IS_PRESENT (BINARY_DIMENSION_TYPES << 5)
+
+static void _get_binary_members(escdf_grid_scalarfield_t *scalarfield,
+                                _uint_set_t **uints, _bool_set_t **bools)
+{
+    uints[0] = &scalarfield->cell.number_of_physical_dimensions;
+    uints[1] = &scalarfield->number_of_components;
+    uints[2] = &scalarfield->real_or_complex;
+    uints[3] = &scalarfield->storage_precision;
+    uints[4] = &scalarfield->number_of_levels;
+    uints[5] = &scalarfield->keyframe_interval;
+    uints[6] = &scalarfield->compression_level;
+    bools[0] = &scalarfield->use_default_ordering;
+    bools[1] = &scalarfield->use_complex_type;
+    bools[2] = &scalarfield->use_grid_layout;
+    bools[3] = &scalarfield->use_chunk_statistics;
+    bools[4] = &scalarfield->use_time_series;
+}
+
+escdf_errno_t escdf_grid_scalarfield_serialise_binary(const escdf_grid_scalarfield_t *scalarfield,
+                                                      FILE *f,
+                                                      const double *values,
+                                                      const size_t len)
+{
+    _uint_set_t *uints[BINARY_NUM_UINTS];
+    _bool_set_t *bools[BINARY_NUM_BOOLS];
+    uint32_t header[3], mask, path_len, scalars[BINARY_NUM_UINTS + BINARY_NUM_BOOLS];
+    uint32_t arr[3];
+    uint64_t nvalues;
+    unsigned int i, npd;
+    bool ok;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(f, ESCDF_EVALUE);
+    FULFILL_OR_RETURN(values || !len, ESCDF_EVALUE);
+
+    _get_binary_members((escdf_grid_scalarfield_t*)scalarfield, uints, bools);
+    mask = 0;
+    for (i = 0; i < BINARY_NUM_UINTS; i++) {
+        mask |= (uints[i]->is_set) ? 1u << i : 0;
+        scalars[i] = uints[i]->value;
+    }
+    for (i = 0; i < BINARY_NUM_BOOLS; i++) {
+        mask |= (bools[i]->is_set) ? 1u << (BINARY_NUM_UINTS + i) : 0;
+        scalars[BINARY_NUM_UINTS + i] = bools[i]->value;
+    }
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    if (scalarfield->cell.number_of_physical_dimensions.is_set) {
+        mask |= (scalarfield->cell.dimension_types) ? BINARY_DIMENSION_TYPES : 0;
+        mask |= (scalarfield->cell.lattice_vectors) ? BINARY_LATTICE_VECTORS : 0;
+        mask |= (scalarfield->number_of_grid_points) ? BINARY_NUMBER_OF_GRID_POINTS : 0;
+        mask |= (scalarfield->grid_chunk_dims) ? BINARY_GRID_CHUNK_DIMS : 0;
+    }
+    mask |= (scalarfield->values_on_grid_is_present) ? BINARY_VALUES_ON_GRID_IS_PRESENT : 0;
+    mask |= (scalarfield->grid_ordering_is_present) ? BINARY_GRID_ORDERING_IS_PRESENT : 0;
+
+    header[0] = BINARY_BYTE_ORDER;
+    header[1] = BINARY_VERSION;
+    header[2] = mask;
+    FULFILL_OR_RETURN(strlen(scalarfield->path) <= BINARY_MAX_PATH_LEN, ESCDF_ERANGE);
+    path_len = strlen(scalarfield->path);
+    ok = fwrite(BINARY_MAGIC, 1, 8, f) == 8 &&
+        fwrite(header, sizeof(uint32_t), 3, f) == 3 &&
+        fwrite(&path_len, sizeof(uint32_t), 1, f) == 1 &&
+        fwrite(scalarfield->path, 1, path_len, f) == path_len &&
+        fwrite(scalars, sizeof(uint32_t), BINARY_NUM_UINTS + BINARY_NUM_BOOLS, f) ==
+        BINARY_NUM_UINTS + BINARY_NUM_BOOLS;
+
+    if (ok && (mask & BINARY_DIMENSION_TYPES)) {
+        for (i = 0; i < npd; i++) {
+            arr[i] = scalarfield->cell.dimension_types[i];
+        }
+        ok = fwrite(arr, sizeof(uint32_t), npd, f) == npd;
+    }
+    if (ok && (mask & BINARY_LATTICE_VECTORS)) {
+        ok = fwrite(scalarfield->cell.lattice_vectors, sizeof(double), npd * npd, f) == npd * npd;
+    }
+    if (ok && (mask & BINARY_NUMBER_OF_GRID_POINTS)) {
+        for (i = 0; i < npd; i++) {
+            arr[i] = scalarfield->number_of_grid_points[i];
+        }
+        ok = fwrite(arr, sizeof(uint32_t), npd, f) == npd;
+    }
+    if (ok && (mask & BINARY_GRID_CHUNK_DIMS)) {
+        for (i = 0; i < npd; i++) {
+            arr[i] = scalarfield->grid_chunk_dims[i];
+        }
+        ok = fwrite(arr, sizeof(uint32_t), npd, f) == npd;
+    }
+
+    nvalues = len;
+    ok = ok && fwrite(&nvalues, sizeof(uint64_t), 1, f) == 1 &&
+        (!len || fwrite(values, sizeof(double), len, f) == len);
+    FULFILL_OR_RETURN(ok, ESCDF_ERROR);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_grid_scalarfield_deserialise_binary(escdf_grid_scalarfield_t *scalarfield,
+                                                        FILE *f,
+                                                        double **values,
+                                                        size_t *len)
+{
+    _uint_set_t *uints[BINARY_NUM_UINTS];
+    _bool_set_t *bools[BINARY_NUM_BOOLS];
+    uint32_t header[3], mask, path_len, scalars[BINARY_NUM_UINTS + BINARY_NUM_BOOLS];
+    uint32_t arr[3];
+    uint64_t nvalues;
+    char magic[8];
+    double skip[256];
+    unsigned int i, npd, nuints;
+    size_t n;
+
+    FULFILL_OR_RETURN(scalarfield, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(f, ESCDF_EVALUE);
+
+    if (values) {
+        *values = NULL;
+    }
+    if (len) {
+        *len = 0;
+    }
+
+    FULFILL_OR_RETURN(fread(magic, 1, 8, f) == 8 &&
+                      fread(header, sizeof(uint32_t), 3, f) == 3, ESCDF_ERROR);
+    FULFILL_OR_RETURN(!memcmp(magic, BINARY_MAGIC, 8) &&
+                      header[0] == BINARY_BYTE_ORDER &&
+                      header[1] >= 1u && header[1] <= BINARY_VERSION, ESCDF_EVALUE);
+    mask = header[2];
+    /* Version 1 has no compression_level, the last unsigned integer. */
+    nuints = (header[1] == 1u) ? BINARY_NUM_UINTS - 1 : BINARY_NUM_UINTS;
+    FULFILL_OR_RETURN(fread(&path_len, sizeof(uint32_t), 1, f) == 1, ESCDF_ERROR);
+    FULFILL_OR_RETURN(path_len <= BINARY_MAX_PATH_LEN, ESCDF_ERANGE);
+    free(scalarfield->path);
+    scalarfield->path = malloc((size_t)path_len + 1);
+    FULFILL_OR_RETURN(scalarfield->path != NULL, ESCDF_ENOMEM);
+    FULFILL_OR_RETURN(fread(scalarfield->path, 1, path_len, f) == path_len, ESCDF_ERROR);
+    scalarfield->path[path_len] = '\0';
+    FULFILL_OR_RETURN(fread(scalars, sizeof(uint32_t), nuints + BINARY_NUM_BOOLS, f) ==
+                      nuints + BINARY_NUM_BOOLS, ESCDF_ERROR);
+    if (nuints < BINARY_NUM_UINTS) {
+        memmove(scalars + BINARY_NUM_UINTS, scalars + nuints, sizeof(uint32_t) * BINARY_NUM_BOOLS);
+        for (i = nuints; i < BINARY_NUM_UINTS; i++) {
+            scalars[i] = 0;
+        }
+        mask = (mask & ((1u << nuints) - 1u)) | ((mask >> nuints) << BINARY_NUM_UINTS);
+    }
+
+    _get_binary_members(scalarfield, uints, bools);
+    for (i = 0; i < BINARY_NUM_UINTS; i++) {
+        uints[i]->is_set = (mask >> i) & 1u;
+        uints[i]->value = scalars[i];
+    }
+    for (i = 0; i < BINARY_NUM_BOOLS; i++) {
+        bools[i]->is_set = (mask >> (BINARY_NUM_UINTS + i)) & 1u;
+        bools[i]->value = scalars[BINARY_NUM_UINTS + i];
+    }
+    npd = scalarfield->cell.number_of_physical_dimensions.value;
+    FULFILL_OR_RETURN(npd <= 3, ESCDF_ERANGE);
+
+    free(scalarfield->cell.dimension_types);
+    scalarfield->cell.dimension_types = NULL;
+    if (mask & BINARY_DIMENSION_TYPES) {
+        FULFILL_OR_RETURN(fread(arr, sizeof(uint32_t), npd, f) == npd, ESCDF_ERROR);
+        scalarfield->cell.dimension_types = malloc(sizeof(int) * npd);
+        for (i = 0; i < npd; i++) {
+            scalarfield->cell.dimension_types[i] = (int)arr[i];
+        }
+    }
+    free(scalarfield->cell.lattice_vectors);
+    scalarfield->cell.lattice_vectors = NULL;
+    if (mask & BINARY_LATTICE_VECTORS) {
+        scalarfield->cell.lattice_vectors = malloc(sizeof(double) * npd * npd);
+        FULFILL_OR_RETURN(fread(scalarfield->cell.lattice_vectors, sizeof(double),
+                                npd * npd, f) == npd * npd, ESCDF_ERROR);
+    }
+    free(scalarfield->number_of_grid_points);
+    scalarfield->number_of_grid_points = NULL;
+    if (mask & BINARY_NUMBER_OF_GRID_POINTS) {
+        FULFILL_OR_RETURN(fread(arr, sizeof(uint32_t), npd, f) == npd, ESCDF_ERROR);
+        scalarfield->number_of_grid_points = malloc(sizeof(unsigned int) * npd);
+        for (i = 0; i < npd; i++) {
+            scalarfield->number_of_grid_points[i] = arr[i];
+        }
+    }
+    free(scalarfield->grid_chunk_dims);
+    scalarfield->grid_chunk_dims = NULL;
+    if (mask & BINARY_GRID_CHUNK_DIMS) {
+        FULFILL_OR_RETURN(fread(arr, sizeof(uint32_t), npd, f) == npd, ESCDF_ERROR);
+        scalarfield->grid_chunk_dims = malloc(sizeof(unsigned int) * npd);
+        for (i = 0; i < npd; i++) {
+            scalarfield->grid_chunk_dims[i] = arr[i];
+        }
+    }
+    scalarfield->values_on_grid_is_present = (mask & BINARY_VALUES_ON_GRID_IS_PRESENT) != 0;
+    scalarfield->grid_ordering_is_present = (mask & BINARY_GRID_ORDERING_IS_PRESENT) != 0;
+
+    /* The values are always consumed, so that several scalarfields
+       can follow each other in a stream that cannot seek. */
+    FULFILL_OR_RETURN(fread(&nvalues, sizeof(uint64_t), 1, f) == 1, ESCDF_ERROR);
+    FULFILL_OR_RETURN(nvalues <= SIZE_MAX / sizeof(double), ESCDF_ERANGE);
+    if (values && nvalues > 0) {
+        *values = malloc(sizeof(double) * (size_t)nvalues);
+        FULFILL_OR_RETURN(*values != NULL, ESCDF_ENOMEM);
+        if (fread(*values, sizeof(double), nvalues, f) != nvalues) {
+            free(*values);
+            *values = NULL;
+            RETURN_WITH_ERROR(ESCDF_ERROR);
+        }
+    } else {
+        for (; nvalues > 0; nvalues -= n) {
+            n = (nvalues < 256) ? nvalues : 256;
+            FULFILL_OR_RETURN(fread(skip, sizeof(double), n, f) == n, ESCDF_ERROR);
+        }
+    }
+    if (len && values) {
+        *len = nvalues;
+    }
 
     return ESCDF_SUCCESS;
 }
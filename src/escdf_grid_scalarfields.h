@@ -53,6 +53,16 @@ typedef enum {
   ESCDF_COMPLEX = 2
 } escdf_real_or_complex;
 
+typedef enum {
+  ESCDF_PRECISION_DOUBLE = 0,
+  ESCDF_PRECISION_SINGLE
+} escdf_storage_precision;
+
+typedef enum {
+  ESCDF_INTERPOLATION_LINEAR = 0,
+  ESCDF_INTERPOLATION_CUBIC
+} escdf_interpolation_method;
+
 /******************************************************************************
  * Global functions                                                           *
  ******************************************************************************/
@@ -139,8 +149,200 @@ escdf_errno_t escdf_grid_scalarfield_set_use_default_ordering(escdf_grid_scalarf
                                                               const bool use_default_ordering);
 bool escdf_grid_scalarfield_get_use_default_ordering(const escdf_grid_scalarfield_t *scalarfield);
 
+/**
+ * Sets the floating point precision used to store values_on_grid on
+ * disk. It defaults to ESCDF_PRECISION_DOUBLE. With
+ * ESCDF_PRECISION_SINGLE, values are stored as IEEE 32 bits floats
+ * and HDF5 converts them on the fly from or to the memory buffers,
+ * which can be either double or float.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] storage_precision: the precision on disk.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_storage_precision(escdf_grid_scalarfield_t *scalarfield,
+                                                           const escdf_storage_precision storage_precision);
+escdf_storage_precision escdf_grid_scalarfield_get_storage_precision(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * For complex scalarfields, store values_on_grid with a compound {r, i}
+ * HDF5 type instead of a trailing dimension of length 2. The dataset
+ * is then of shape [number_of_components, number of grid points]. The
+ * memory layout of the buffers is unchanged and matches C99 double
+ * complex or C++ std::complex<double>. When given, the trailing
+ * real_or_complex entry of start, count and stride is ignored.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] use_complex_type: true to use the compound type.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_use_complex_type(escdf_grid_scalarfield_t *scalarfield,
+                                                          const bool use_complex_type);
+bool escdf_grid_scalarfield_get_use_complex_type(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * Store values_on_grid with one dimension per physical direction,
+ * [number_of_components, nz, ny, nx, real_or_complex], instead of the
+ * flattened [number_of_components, nx * ny * nz, real_or_complex]
+ * shape. The dataset is then chunked in 3D, so that a process owning
+ * a sub-box of the grid only accesses the chunks it overlaps. In
+ * escdf_grid_scalarfield_read_values_on_grid() and
+ * escdf_grid_scalarfield_write_values_on_grid(), start, count and
+ * stride follow the shape of the dataset. The sliced functions work
+ * with both layouts, and files with the flattened layout are still
+ * read. The grid layout requires the default ordering.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] use_grid_layout: true to use one dimension per direction.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_use_grid_layout(escdf_grid_scalarfield_t *scalarfield,
+                                                         const bool use_grid_layout);
+bool escdf_grid_scalarfield_get_use_grid_layout(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * Sets the chunk size, in number of grid points along each direction
+ * (in the order of number_of_grid_points), used with the grid
+ * layout. It defaults to 32 points along each direction, bounded by
+ * the grid size. A chunk always holds a single component.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] grid_chunk_dims: the chunk size along each direction.
+ * @param[in] len: number_of_physical_dimensions.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_grid_chunk_dims(escdf_grid_scalarfield_t *scalarfield,
+                                                         const unsigned int *grid_chunk_dims,
+                                                         const size_t len);
+escdf_errno_t escdf_grid_scalarfield_get_grid_chunk_dims(const escdf_grid_scalarfield_t *scalarfield,
+                                                         unsigned int *grid_chunk_dims,
+                                                         const size_t len);
+
+/**
+ * Sets the number of coarsened levels stored along values_on_grid,
+ * for previews. Level l has ceil(n / 2^l) grid points along each
+ * direction, each value being the average of the corresponding block
+ * of 2x2x2 values of level l - 1. Levels are written together with
+ * values_on_grid when the full field is given at once to
+ * escdf_grid_scalarfield_write_values_on_grid(), or with
+ * escdf_grid_scalarfield_write_levels() otherwise. It defaults to
+ * zero, level 0 being values_on_grid itself.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] number_of_levels: the number of coarsened levels.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_number_of_levels(escdf_grid_scalarfield_t *scalarfield,
+                                                         const unsigned int number_of_levels);
+unsigned int escdf_grid_scalarfield_get_number_of_levels(const escdf_grid_scalarfield_t *scalarfield);
+escdf_errno_t escdf_grid_scalarfield_get_level_number_of_grid_points(const escdf_grid_scalarfield_t *scalarfield,
+                                                                     unsigned int level,
+                                                                     unsigned int *number_of_grid_points,
+                                                                     const size_t len);
+
+/**
+ * Sets whether the minimum and maximum of the values are also stored
+ * for each chunk of grid points (see
+ * escdf_grid_scalarfield_set_grid_chunk_dims()), so that readers can
+ * skip the chunks outside of a range of values. It defaults to false.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] use_chunk_statistics: true to store per-chunk bounds.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_use_chunk_statistics(escdf_grid_scalarfield_t *scalarfield,
+                                                              const bool use_chunk_statistics);
+bool escdf_grid_scalarfield_get_use_chunk_statistics(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * Sets whether a time series of values_on_grid snapshots (SCF
+ * iterations, TDDFT steps...) is stored along with values_on_grid. The
+ * snapshots are appended to a single extendible dataset,
+ * values_on_grid_frames, and share the metadata and grid_ordering of
+ * the group. It defaults to false.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] use_time_series: true to create values_on_grid_frames.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_use_time_series(escdf_grid_scalarfield_t *scalarfield,
+                                                         const bool use_time_series);
+bool escdf_grid_scalarfield_get_use_time_series(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * Sets the keyframe interval n of values_on_grid_frames. With n > 1,
+ * one frame every n is stored as is, and the others as compressed
+ * deltas against their keyframe, so that appending or reading a
+ * frame only involves that frame and its keyframe. The encoding is
+ * lossless. It defaults to 0, every frame being stored as is.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] keyframe_interval: the number of frames between keyframes.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_keyframe_interval(escdf_grid_scalarfield_t *scalarfield,
+                                                           const unsigned int keyframe_interval);
+unsigned int escdf_grid_scalarfield_get_keyframe_interval(const escdf_grid_scalarfield_t *scalarfield);
+
+/**
+ * Sets the deflate level, from 0 to 9, used to compress values_on_grid,
+ * after a shuffle filter. It defaults to 0, no compression. Without the
+ * grid layout, the values are then chunked along the grid points, the
+ * chunks following the slices of
+ * escdf_grid_scalarfield_write_values_on_grid_redistributed() for the
+ * number of processes of the handle given to
+ * escdf_grid_scalarfield_write_metadata(). Chunks are thus aligned on
+ * the slices only for that writer, or for sliced writes using the same
+ * block decomposition. With other slice lengths, which are not known
+ * when the metadata are written, a chunk may be shared by neighbouring
+ * processes. In parallel, compressed
+ * values are always written with collective transfers, as HDF5 requires.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] compression_level: the deflate level.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_set_compression_level(escdf_grid_scalarfield_t *scalarfield,
+                                                           const unsigned int compression_level);
+unsigned int escdf_grid_scalarfield_get_compression_level(const escdf_grid_scalarfield_t *scalarfield);
+
 escdf_errno_t escdf_grid_scalarfield_serialise(escdf_grid_scalarfield_t *scalarfield, FILE *f);
 
+/**
+ * Writes the full description of the scalarfield in a compact binary
+ * form, optionally followed by values, so that it can be exchanged
+ * between processes through pipes or shared memory. The native byte
+ * order is used and checked on reading.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] f: the stream to write to.
+ * @param[in] values: values to append, may be NULL.
+ * @param[in] len: the number of values.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_serialise_binary(const escdf_grid_scalarfield_t *scalarfield,
+                                                      FILE *f,
+                                                      const double *values,
+                                                      const size_t len);
+
+/**
+ * Reads back a scalarfield written by
+ * escdf_grid_scalarfield_serialise_binary(), replacing all the
+ * members of scalarfield, including its path. Streams of the first
+ * version of the format, without compression level, are accepted.
+ *
+ * @param[in,out] scalarfield: instance of the scalarfield group.
+ * @param[in] f: the stream to read from.
+ * @param[out] values: if not NULL, the allocated values, or NULL if
+ * there is none. They are skipped otherwise.
+ * @param[out] len: if not NULL, the number of values.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_deserialise_binary(escdf_grid_scalarfield_t *scalarfield,
+                                                        FILE *f,
+                                                        double **values,
+                                                        size_t *len);
+
 /*******************/
 /* Data functions. */
 /*******************/
@@ -175,6 +377,422 @@ escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced(const escdf_grid
                                                                 const unsigned int *tbl,
                                                                 const hsize_t len);
 
+/* Same as above, but with single precision memory buffers. */
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                escdf_handle_t *file_id,
+                                                                const float *buf,
+                                                                const unsigned int *tbl,
+                                                                const hsize_t *start,
+                                                                const hsize_t *count,
+                                                                const hsize_t *stride);
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                       escdf_handle_t *file_id,
+                                                                       const float *buf,
+                                                                       const unsigned int *tbl,
+                                                                       const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id,
+                                                               float *buf,
+                                                               const hsize_t *start,
+                                                               const hsize_t *count,
+                                                               const hsize_t *stride);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                      escdf_handle_t *file_id,
+                                                                      float *buf,
+                                                                      const unsigned int *tbl,
+                                                                      const hsize_t len);
+
+/**
+ * Computes the offset, in the global zyx ordering, of the slice of
+ * len points owned by the calling process, and checks that the slices
+ * of all processes cover the grid exactly. This is collective.
+ *
+ * The sliced functions compute it on every call. When the same
+ * decomposition is used for several writes or reads, the offset can
+ * be computed once and given to the *_sliced_at() variants below,
+ * which skip these collective operations.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the file handle.
+ * @param[in] len: the size of the local slice.
+ * @param[out] offset: the offset of the local slice.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_get_slice_offset(const escdf_grid_scalarfield_t *scalarfield,
+                                                      escdf_handle_t *file_id,
+                                                      const hsize_t len,
+                                                      hsize_t *offset);
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                    escdf_handle_t *file_id,
+                                                                    const double *buf,
+                                                                    const unsigned int *tbl,
+                                                                    const hsize_t offset,
+                                                                    const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_sliced_float_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                          escdf_handle_t *file_id,
+                                                                          const float *buf,
+                                                                          const unsigned int *tbl,
+                                                                          const hsize_t offset,
+                                                                          const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                   escdf_handle_t *file_id,
+                                                                   double *buf,
+                                                                   const unsigned int *tbl,
+                                                                   const hsize_t offset,
+                                                                   const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_sliced_float_at(const escdf_grid_scalarfield_t *scalarfield,
+                                                                         escdf_handle_t *file_id,
+                                                                         float *buf,
+                                                                         const unsigned int *tbl,
+                                                                         const hsize_t offset,
+                                                                         const hsize_t len);
+
+/**
+ * Same as escdf_grid_scalarfield_write_values_on_grid_sliced() with a
+ * non-default ordering @tbl, but the values are first exchanged
+ * between processes, so that each one writes a contiguous block of
+ * ceil(npoints / nprocs) points of the default ordering, the last
+ * processes possibly writing fewer points or none. These blocks are
+ * made of whole chunks when values_on_grid is compressed. The
+ * scalarfield must use the default ordering, no grid_ordering table
+ * is written, and later reads are contiguous. This is a collective
+ * call.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the file handle.
+ * @param[in] buf: values of the scalarfield on a slice of grid
+ * points, with the full component values for each points.
+ * @param[in] tbl: for each point of the slice, its index in the
+ * global zyx ordering.
+ * @param[in] len: the size of the slice.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                                        escdf_handle_t *file_id,
+                                                                        const double *buf,
+                                                                        const unsigned int *tbl,
+                                                                        const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_redistributed_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                              escdf_handle_t *file_id,
+                                                                              const float *buf,
+                                                                              const unsigned int *tbl,
+                                                                              const hsize_t len);
+
+/**
+ * Same as escdf_grid_scalarfield_read_values_on_grid_sliced() with a
+ * lookup table @tbl, but in two phases: each process reads a
+ * contiguous block of ceil(npoints / nprocs) stored values, matching
+ * whole chunks when values_on_grid is compressed, which are then sent
+ * to the processes requesting them. It suits scattered
+ * decompositions, which otherwise lead to point-wise reads. The
+ * requested points may be any subset of the grid, possibly repeated.
+ * This is a collective call.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the file handle.
+ * @param[out] buf: values of the scalarfield on the requested points,
+ * with the full component values for each points.
+ * @param[in] tbl: for each requested point, its index in the global
+ * zyx ordering.
+ * @param[in] len: the number of requested points.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_redistributed(const escdf_grid_scalarfield_t *scalarfield,
+                                                                       escdf_handle_t *file_id,
+                                                                       double *buf,
+                                                                       const unsigned int *tbl,
+                                                                       const hsize_t len);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_redistributed_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                             escdf_handle_t *file_id,
+                                                                             float *buf,
+                                                                             const unsigned int *tbl,
+                                                                             const hsize_t len);
+
+/**
+ * Same as escdf_grid_scalarfield_write_values_on_grid() and
+ * escdf_grid_scalarfield_read_values_on_grid(), but the values are
+ * taken from, or placed into, a sub-block of a larger user array, like
+ * a local block with ghost layers. The user array is a dense array of
+ * shape @mem_dims (in units of doubles, or of complex values when
+ * the compound complex type is used) and the sub-block is given by
+ * @mem_start, @mem_count and @mem_stride.
+ */
+escdf_errno_t escdf_grid_scalarfield_write_values_on_grid_mem(const escdf_grid_scalarfield_t *scalarfield,
+                                                              escdf_handle_t *file_id,
+                                                              const double *buf,
+                                                              const unsigned int *tbl,
+                                                              const hsize_t *start,
+                                                              const hsize_t *count,
+                                                              const hsize_t *stride,
+                                                              const hsize_t *mem_dims,
+                                                              unsigned int mem_ndims,
+                                                              const hsize_t *mem_start,
+                                                              const hsize_t *mem_count,
+                                                              const hsize_t *mem_stride);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_mem(const escdf_grid_scalarfield_t *scalarfield,
+                                                             escdf_handle_t *file_id,
+                                                             double *buf,
+                                                             const hsize_t *start,
+                                                             const hsize_t *count,
+                                                             const hsize_t *stride,
+                                                             const hsize_t *mem_dims,
+                                                             unsigned int mem_ndims,
+                                                             const hsize_t *mem_start,
+                                                             const hsize_t *mem_count,
+                                                             const hsize_t *mem_stride);
+
+
+/**
+ * Reads all the components of the values on a box of grid points,
+ * with either layout. @start and @count give, along each direction in
+ * the order of number_of_grid_points, the first grid point and the
+ * number of grid points of the box. The values are stored in @buf as
+ * [number_of_components, count[2], count[1], count[0],
+ * real_or_complex]. With the grid layout this is a single hyperslab,
+ * otherwise the lines along x are read in a single transfer.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] buf: values of the scalarfield on the box.
+ * @param[in] start: the first grid point of the box.
+ * @param[in] count: the number of grid points of the box.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_box(const escdf_grid_scalarfield_t *scalarfield,
+                                                             escdf_handle_t *file_id,
+                                                             double *buf,
+                                                             const hsize_t *start,
+                                                             const hsize_t *count);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_box_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                   escdf_handle_t *file_id,
+                                                                   float *buf,
+                                                                   const hsize_t *start,
+                                                                   const hsize_t *count);
+
+/**
+ * Computes the box of grid points enclosing a Cartesian bounding box,
+ * using the lattice vectors and the number of grid points. Grid point
+ * k along direction i is located at k / number_of_grid_points[i] in
+ * reduced coordinates. The box is restricted to the cell; there is no
+ * wrapping across periodic boundaries.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] lower: the lower corner of the Cartesian box.
+ * @param[in] upper: the upper corner of the Cartesian box.
+ * @param[out] start: the first grid point of the region.
+ * @param[out] count: the number of grid points of the region.
+ * @return error code, ESCDF_ERANGE if the box does not overlap the cell.
+ */
+escdf_errno_t escdf_grid_scalarfield_get_region(const escdf_grid_scalarfield_t *scalarfield,
+                                                const double *lower,
+                                                const double *upper,
+                                                hsize_t *start,
+                                                hsize_t *count);
+
+/**
+ * Reads the values on the region given by
+ * escdf_grid_scalarfield_get_region(), as
+ * escdf_grid_scalarfield_read_values_on_grid_box() does. Only the
+ * chunks, or lines along x, overlapping the region are read. The size
+ * of @buf can be obtained from escdf_grid_scalarfield_get_region().
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] buf: values of the scalarfield on the region.
+ * @param[in] lower: the lower corner of the Cartesian box.
+ * @param[in] upper: the upper corner of the Cartesian box.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_region(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 double *buf,
+                                                 const double *lower,
+                                                 const double *upper);
+
+/**
+ * Reads the values on a box of grid points, as
+ * escdf_grid_scalarfield_read_values_on_grid_box(), extended by
+ * @nghost ghost layers on each side. Along periodic directions, as
+ * given by dimension_types, the ghost layers wrap around the cell;
+ * along other directions, ghost values outside of the cell are set to
+ * zero. The values are stored in @buf as [number_of_components,
+ * count[2] + 2 * nghost, count[1] + 2 * nghost, count[0] + 2 * nghost,
+ * real_or_complex]. This is a collective call: the wrapped pieces are
+ * read separately, and every rank issues as many reads as the rank
+ * with the most pieces.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] buf: values of the scalarfield on the extended box.
+ * @param[in] start: the first grid point of the box, without ghosts.
+ * @param[in] count: the number of grid points of the box, without ghosts.
+ * @param[in] nghost: the number of ghost layers.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_halo(const escdf_grid_scalarfield_t *scalarfield,
+                                                              escdf_handle_t *file_id,
+                                                              double *buf,
+                                                              const hsize_t *start,
+                                                              const hsize_t *count,
+                                                              unsigned int nghost);
+
+/**
+ * Computes and writes the coarsened levels from values_on_grid, as
+ * stored on disk. To be called once values_on_grid has been fully
+ * written, by pieces or by slices. The full field is read in memory.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_write_levels(const escdf_grid_scalarfield_t *scalarfield,
+                                                  escdf_handle_t *file_id);
+
+/**
+ * Reads all the values of a given level, stored in @buf as
+ * [number_of_components, nz, ny, nx, real_or_complex] with the grid
+ * points of escdf_grid_scalarfield_get_level_number_of_grid_points().
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[in] level: the level, 0 for values_on_grid itself.
+ * @param[out] buf: values of the scalarfield on the level.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_level(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id,
+                                                               unsigned int level,
+                                                               double *buf);
+
+/**
+ * Interpolates the values at arbitrary Cartesian points, with
+ * trilinear or tricubic (Catmull-Rom) interpolation between grid
+ * points. Grid point k along direction i is located at k /
+ * number_of_grid_points[i] in reduced coordinates of the lattice
+ * vectors. Along periodic directions the interpolation wraps around
+ * the cell, along other directions it is clamped to the border. Only
+ * the grid points around the requested points are read; the points
+ * are processed by batches sorted by chunk.
+ *
+ * This is a collective call on parallel handles, but each rank may
+ * give its own points, or none. The points are read with independent
+ * transfers.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[in] method: ESCDF_INTERPOLATION_LINEAR or ESCDF_INTERPOLATION_CUBIC.
+ * @param[in] num_points: the number of points.
+ * @param[in] points: the Cartesian coordinates, num_points x
+ * number_of_physical_dimensions.
+ * @param[out] values: the interpolated values, num_points x
+ * number_of_components x real_or_complex.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_interpolate(const escdf_grid_scalarfield_t *scalarfield,
+                                                 escdf_handle_t *file_id,
+                                                 escdf_interpolation_method method,
+                                                 size_t num_points,
+                                                 const double *points,
+                                                 double *values);
+
+/**
+ * Reads the statistics of values_on_grid, computed and stored as
+ * attributes of the group when the full field is written, either at
+ * once or by slices. Each array has number_of_components x
+ * real_or_complex values; the integral is the sum times the volume
+ * of the cell divided by the number of grid points. Any array may be
+ * NULL.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] minimum: the minimum of each component.
+ * @param[out] maximum: the maximum of each component.
+ * @param[out] sum: the sum of each component.
+ * @param[out] integral: the integral of each component over the cell.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_statistics(const escdf_grid_scalarfield_t *scalarfield,
+                                                     escdf_handle_t *file_id,
+                                                     double *minimum,
+                                                     double *maximum,
+                                                     double *sum,
+                                                     double *integral);
+
+/**
+ * Reads the per-chunk bounds of values_on_grid, when
+ * use_chunk_statistics is set. Each array is shaped
+ * [number_of_components, chunks along z, y, x, real_or_complex], the
+ * number of chunks along direction i being ceil(number_of_grid_points[i]
+ * / grid_chunk_dims[i]). Any array may be NULL.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] minimum: the minimum in each chunk.
+ * @param[out] maximum: the maximum in each chunk.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_chunk_statistics(const escdf_grid_scalarfield_t *scalarfield,
+                                                           escdf_handle_t *file_id,
+                                                           double *minimum,
+                                                           double *maximum);
+
+/**
+ * Gets the number of snapshots stored in values_on_grid_frames, when
+ * use_time_series is set.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[out] number_of_frames: the number of appended snapshots.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_get_number_of_frames(const escdf_grid_scalarfield_t *scalarfield,
+                                                          escdf_handle_t *file_id,
+                                                          size_t *number_of_frames);
+
+/**
+ * Appends a full snapshot of the field to values_on_grid_frames, in
+ * the same layout as escdf_grid_scalarfield_write_values_on_grid()
+ * with no selection. Without the default ordering, the lookup table
+ * must be given with the first frame and is written once to
+ * grid_ordering; it is ignored for the following frames, which must
+ * use the same ordering.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[in] buf: the values of the snapshot.
+ * @param[in] tbl: the lookup table, or NULL.
+ * @param[out] frame: if not NULL, the index of the new frame.
+ * @return error code.
+ */
+escdf_errno_t escdf_grid_scalarfield_append_values_on_grid(const escdf_grid_scalarfield_t *scalarfield,
+                                                           escdf_handle_t *file_id,
+                                                           const double *buf,
+                                                           const unsigned int *tbl,
+                                                           size_t *frame);
+escdf_errno_t escdf_grid_scalarfield_append_values_on_grid_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                 escdf_handle_t *file_id,
+                                                                 const float *buf,
+                                                                 const unsigned int *tbl,
+                                                                 size_t *frame);
+
+/**
+ * Reads one snapshot of values_on_grid_frames, in the same layout as
+ * escdf_grid_scalarfield_read_values_on_grid() with no selection.
+ *
+ * @param[in] scalarfield: instance of the scalarfield group.
+ * @param[in] file_id: the handle on the opened HDF5 file.
+ * @param[in] frame: the index of the snapshot.
+ * @param[out] buf: the values of the snapshot.
+ * @return error code, ESCDF_ERANGE if frame is not stored.
+ */
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_frame(const escdf_grid_scalarfield_t *scalarfield,
+                                                               escdf_handle_t *file_id,
+                                                               size_t frame,
+                                                               double *buf);
+escdf_errno_t escdf_grid_scalarfield_read_values_on_grid_frame_float(const escdf_grid_scalarfield_t *scalarfield,
+                                                                     escdf_handle_t *file_id,
+                                                                     size_t frame,
+                                                                     float *buf);
 
 #ifdef __cplusplus
 }
@@ -315,6 +315,7 @@ escdf_group_t * escdf_group_new(escdf_group_id_t group_id)
 #endif
 
     group->loc_id = ESCDF_UNDEFINED_ID; /* was -1 */
+    group->escdf_handle = NULL;
 
     if(group->specs->nattributes>0) {
         group->attr = (escdf_attribute_t **) malloc(group->specs->nattributes * sizeof(escdf_attribute_t *));
@@ -404,6 +405,8 @@ escdf_errno_t escdf_group_open_location(escdf_group_t *group, const escdf_handle
 
     /*  FULFILL_OR_RETURN(group->loc_id >= 0, group->loc_id); */
 
+    group->escdf_handle = handle;
+
     return ESCDF_SUCCESS;
 }
 
@@ -576,7 +579,7 @@ escdf_errno_t escdf_group_close(escdf_group_t *group)
 }
 
 
-escdf_errno_t escdf_group_read_attributes(escdf_group_t *group)
+static escdf_errno_t _escdf_group_read_attributes(escdf_group_t *group)
 {
     unsigned int iattr;
     escdf_errno_t error;
@@ -615,6 +618,122 @@ escdf_errno_t escdf_group_read_attributes(escdf_group_t *group)
     return ESCDF_SUCCESS;
 }
 
+#ifdef HAVE_MPI
+/* Rank 0 reads all the attributes and packs them, in the order of
+   the specifications, as a flag telling whether the attribute is set
+   followed by its value. The other ranks fill their attributes from
+   the broadcast buffer: since dimension attributes come first, the
+   size of each attribute is known when it is reached. */
+static escdf_errno_t _escdf_group_read_attributes_bcast(escdf_group_t *group)
+{
+    const escdf_handle_t *handle = group->escdf_handle;
+    unsigned int iattr;
+    escdf_errno_t error;
+    long header[2];
+    size_t len;
+    char *buf, *ptr;
+    bool is_set;
+
+    FULFILL_OR_RETURN(group->specs != NULL, ESCDF_EVALUE);
+
+    buf = NULL;
+    if (handle->mpi_rank == 0) {
+        error = _escdf_group_read_attributes(group);
+        len = 0;
+        if (error == ESCDF_SUCCESS) {
+            for (iattr = 0; iattr < group->specs->nattributes; iattr++) {
+                len += 1;
+                if (escdf_attribute_is_set(group->attr[iattr])) {
+                    len += escdf_attribute_sizeof(group->attr[iattr]);
+                }
+            }
+            buf = malloc(len);
+            for (ptr = buf, iattr = 0; iattr < group->specs->nattributes; iattr++) {
+                *ptr = escdf_attribute_is_set(group->attr[iattr]);
+                ptr += 1;
+                if (escdf_attribute_is_set(group->attr[iattr])) {
+                    escdf_attribute_get(group->attr[iattr], ptr);
+                    ptr += escdf_attribute_sizeof(group->attr[iattr]);
+                }
+            }
+        }
+        header[0] = error;
+        header[1] = len;
+    }
+
+    MPI_Bcast(header, 2, MPI_LONG, 0, handle->comm);
+    if (header[0] != ESCDF_SUCCESS) {
+        /* The error has already been registered on rank 0. */
+        FULFILL_OR_RETURN(handle->mpi_rank == 0, header[0]);
+        return header[0];
+    }
+    len = header[1];
+    if (handle->mpi_rank != 0) {
+        buf = malloc(len);
+    }
+    MPI_Bcast(buf, (int)len, MPI_BYTE, 0, handle->comm);
+
+    if (handle->mpi_rank != 0) {
+        for (ptr = buf, iattr = 0; iattr < group->specs->nattributes; iattr++) {
+            if (group->attr[iattr] == NULL &&
+                (error = _escdf_group_attribute_new(group, group->specs->attr_specs[iattr]->id)) != ESCDF_SUCCESS) {
+                free(buf);
+                return error;
+            }
+            is_set = *ptr;
+            ptr += 1;
+            if (is_set) {
+                if (!escdf_attribute_is_set(group->attr[iattr])) {
+                    escdf_attribute_set(group->attr[iattr], ptr);
+                }
+                ptr += escdf_attribute_sizeof(group->attr[iattr]);
+            }
+        }
+    }
+    free(buf);
+
+    return ESCDF_SUCCESS;
+}
+
+/* With collective metadata reads, HDF5 already reads the attributes
+   once and broadcasts them, but expects all the ranks to take part:
+   reads done by rank 0 alone would hang. */
+static bool _escdf_group_coll_metadata_reads(const escdf_handle_t *handle)
+{
+    hbool_t coll;
+#if H5_VERSION_GE(1, 10, 0)
+    hid_t fapl_id;
+#endif
+
+    coll = false;
+#if H5_VERSION_GE(1, 10, 0)
+    if ((fapl_id = H5Fget_access_plist(handle->file_id)) >= 0) {
+        if (H5Pget_all_coll_metadata_ops(fapl_id, &coll) < 0) {
+            coll = false;
+        }
+        H5Pclose(fapl_id);
+    }
+#else
+    (void)handle;
+#endif
+    return coll;
+}
+#endif
+
+escdf_errno_t escdf_group_read_attributes(escdf_group_t *group)
+{
+    FULFILL_OR_RETURN(group != NULL, ESCDF_EVALUE);
+
+#ifdef HAVE_MPI
+    if (group->escdf_handle != NULL && group->escdf_handle->mpi_size > 1 &&
+        group->escdf_handle->bcast_attributes &&
+        !_escdf_group_coll_metadata_reads(group->escdf_handle)) {
+        return _escdf_group_read_attributes_bcast(group);
+    }
+#endif
+    return _escdf_group_read_attributes(group);
+}
+
 
 
 
@@ -940,7 +1059,19 @@ escdf_errno_t escdf_group_query_datasets(const escdf_group_t *group)
 
 
 
+static escdf_dataset_t *_escdf_group_dataset_create(escdf_group_t *group, escdf_dataset_id_t dataset_id, bool time_series);
+
 escdf_dataset_t *escdf_group_dataset_create(escdf_group_t *group, escdf_dataset_id_t dataset_id)
+{
+    return _escdf_group_dataset_create(group, dataset_id, false);
+}
+
+escdf_dataset_t *escdf_group_dataset_create_time_series(escdf_group_t *group, escdf_dataset_id_t dataset_id)
+{
+    return _escdf_group_dataset_create(group, dataset_id, true);
+}
+
+static escdf_dataset_t *_escdf_group_dataset_create(escdf_group_t *group, escdf_dataset_id_t dataset_id, bool time_series)
 {
     unsigned int idata, i;
     escdf_dataset_t *dataset;
@@ -974,6 +1105,12 @@ escdf_dataset_t *escdf_group_dataset_create(escdf_group_t *group, escdf_dataset_
 
     dataset = group->datasets[idata];
 
+    if (time_series && escdf_dataset_set_time_series(dataset, true) != ESCDF_SUCCESS) {
+        escdf_dataset_free(dataset);
+        group->datasets[idata] = NULL;
+        FULFILL_OR_RETURN_VAL(false, ESCDF_ERROR, NULL);
+    }
+
     /* print for checks */
 
     /* id = escdf_dataset_get_id(dataset); */
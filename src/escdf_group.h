@@ -156,6 +156,9 @@ escdf_errno_t escdf_group_close_location(escdf_group_t *group);
  *   error if the location does not exist.
  * - call escdf_group_read_metadata to read all the metadata from the file and store it in memory.
  *
+ * With a handle from escdf_open_mpi() or escdf_create_mpi(), this call is
+ * collective: the metadata is read once and broadcast to all ranks.
+ *
  * @param[in] handle: the file/group handle defining the root where to open
  * the "/group" group.
  * @param[in] group_id: Group ID, as defined in the specifications (escdf_groups_ID.h).
@@ -203,7 +206,10 @@ escdf_errno_t escdf_group_close(escdf_group_t *group);
  * @brief Read group attributes
  * 
  * This routine reads all the metadata stored in the group, and stores
- * the information in the group data type.
+ * the information in the group data type. With an MPI handle where
+ * escdf_handle_set_broadcast_attributes() is enabled, only rank 0 reads
+ * the file and the attributes are broadcast to the other ranks, unless
+ * the file uses collective metadata reads.
  *
  * @param[out] group: pointer to instance of the group group.
  * @return error code.
@@ -294,6 +300,18 @@ escdf_errno_t escdf_group_query_datasets(const escdf_group_t *group);
  */
 escdf_dataset_t *escdf_group_dataset_create(escdf_group_t *group, escdf_dataset_id_t dataset_id);
 
+/**
+ * @brief Create new time series dataset in a group
+ * 
+ * The dataset is created empty, with an unlimited leading frame
+ * dimension; see escdf_dataset_set_time_series().
+ * 
+ * @param group 
+ * @param[in] dataset_id 
+ * @return escdf_dataset_t* 
+ */
+escdf_dataset_t *escdf_group_dataset_create_time_series(escdf_group_t *group, escdf_dataset_id_t dataset_id);
+
 /**
  * @brief Open dataset in a group
  * 
@@ -21,6 +21,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "escdf_error.h"
 #include "escdf_handle.h"
@@ -50,6 +51,10 @@ escdf_handle_t * escdf_create(const char *filename, const char *path)
     handle->mpi_rank = 0;
     handle->mpi_size = 1;
     handle->transfer_mode = H5P_DEFAULT;
+#ifdef HAVE_MPI
+    handle->agg_comm = MPI_COMM_NULL;
+    handle->node_comm = MPI_COMM_NULL;
+#endif
     handle->file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
     FULFILL_OR_RETURN_VAL(handle->file_id >= 0, ESCDF_EFILE_CORRUPT, NULL)
 
@@ -74,6 +79,10 @@ escdf_handle_t * escdf_open(const char *filename, const char *path) {
     handle->mpi_rank = 0;
     handle->mpi_size = 1;
     handle->transfer_mode = H5P_DEFAULT;
+#ifdef HAVE_MPI
+    handle->agg_comm = MPI_COMM_NULL;
+    handle->node_comm = MPI_COMM_NULL;
+#endif
     handle->file_id = H5Fopen(filename, H5F_ACC_RDWR, H5P_DEFAULT);
     FULFILL_OR_RETURN_VAL(handle->file_id >= 0, ESCDF_EFILE_CORRUPT, NULL)
 
@@ -95,42 +104,106 @@ escdf_handle_t * escdf_open(const char *filename, const char *path) {
 }
 
 #ifdef HAVE_MPI
+/* The MPI-IO hints given by the caller, overridden by the
+   "key=value;key=value" pairs of the ESCDF_MPI_HINTS environment
+   variable. The returned info must be freed. */
+static MPI_Info _get_mpi_hints(MPI_Info info)
+{
+    MPI_Info hints;
+    const char *env;
+    char *buf, *key, *value, *next;
+
+    if (info == MPI_INFO_NULL) {
+        MPI_Info_create(&hints);
+    } else {
+        MPI_Info_dup(info, &hints);
+    }
+    if ((env = getenv("ESCDF_MPI_HINTS")) == NULL) {
+        return hints;
+    }
+
+    buf = strdup(env);
+    for (key = buf; key != NULL; key = next) {
+        if ((next = strchr(key, ';')) != NULL) {
+            *next++ = '\0';
+        }
+        if ((value = strchr(key, '=')) == NULL || value == key) {
+            continue;
+        }
+        *value++ = '\0';
+        MPI_Info_set(hints, key, value);
+    }
+    free(buf);
+
+    return hints;
+}
+
+/* File access with the MPI-IO driver. Metadata reads and writes are
+   collective, so that HDF5 performs them on one rank and broadcasts
+   the result instead of every rank hitting the file system. */
+static hid_t _create_fapl_mpi(MPI_Comm comm, MPI_Info info)
+{
+    hid_t fapl_id;
+    herr_t err;
+    MPI_Info hints;
+
+    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
+        return fapl_id;
+    }
+    /* HDF5 keeps its own copy of the hints. */
+    hints = _get_mpi_hints(info);
+    err = H5Pset_fapl_mpio(fapl_id, comm, hints);
+    MPI_Info_free(&hints);
+    if (err < 0
+#if H5_VERSION_GE(1, 10, 0)
+        || H5Pset_all_coll_metadata_ops(fapl_id, true) < 0
+        || H5Pset_coll_metadata_write(fapl_id, true) < 0
+#endif
+        ) {
+        H5Pclose(fapl_id);
+        return -1;
+    }
+    return fapl_id;
+}
+
 escdf_handle_t * escdf_create_mpi(const char *filename, const char *path,
     MPI_Comm comm)
+{
+    return escdf_create_mpi_info(filename, path, comm, MPI_INFO_NULL);
+}
+
+escdf_handle_t * escdf_create_mpi_info(const char *filename, const char *path,
+    MPI_Comm comm, MPI_Info info)
 {
     hid_t fapl_id;
-    herr_t err;
     escdf_handle_t *handle = (escdf_handle_t *) malloc(sizeof(escdf_handle_t));
     FULFILL_OR_RETURN_VAL(handle != NULL, ESCDF_ENOMEM, NULL);
 
     handle->comm = comm;
     MPI_Comm_size(handle->comm, &(handle->mpi_size));
     MPI_Comm_rank(handle->comm, &(handle->mpi_rank));
+    handle->bcast_attributes = false;
+    handle->agg_comm = MPI_COMM_NULL;
+    handle->node_comm = MPI_COMM_NULL;
 
     handle->transfer_mode = H5Pcreate(H5P_DATASET_XFER);
     H5Pset_dxpl_mpio(handle->transfer_mode, H5FD_MPIO_COLLECTIVE);
 
-    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
+    if ((fapl_id = _create_fapl_mpi(comm, info)) < 0) {
         H5Pclose(handle->transfer_mode);
         free(handle);
         DEFER_FUNC_ERROR(fapl_id);
         return NULL;
     }
-    if ((err = H5Pset_fapl_mpio(fapl_id, comm, MPI_INFO_NULL)) < 0) {
-        H5Pclose(handle->transfer_mode);
-        H5Pclose(fapl_id);
-        free(handle);
-        DEFER_FUNC_ERROR(fapl_id);
-        return NULL;
-    }
 
     if ((handle->file_id = H5Fcreate(filename, H5F_ACC_TRUNC,
                                      H5P_DEFAULT, fapl_id)) < 0) {
         H5Pclose(handle->transfer_mode);
         H5Pclose(fapl_id);
-        free(handle);
         DEFER_FUNC_ERROR(handle->file_id);
-    };
+        free(handle);
+        return NULL;
+    }
     H5Pclose(fapl_id);
 
     if (_create_root(handle, path) != ESCDF_SUCCESS) {
@@ -143,39 +216,41 @@ escdf_handle_t * escdf_create_mpi(const char *filename, const char *path,
 
 escdf_handle_t * escdf_open_mpi(const char *filename, const char *path,
     MPI_Comm comm)
+{
+    return escdf_open_mpi_info(filename, path, comm, MPI_INFO_NULL);
+}
+
+escdf_handle_t * escdf_open_mpi_info(const char *filename, const char *path,
+    MPI_Comm comm, MPI_Info info)
 {
     hid_t fapl_id;
-    herr_t err;
     escdf_handle_t *handle = (escdf_handle_t *) malloc(sizeof(escdf_handle_t));
     FULFILL_OR_RETURN_VAL(handle != NULL, ESCDF_ENOMEM, NULL);
 
     handle->comm = comm;
     MPI_Comm_size(handle->comm, &(handle->mpi_size));
     MPI_Comm_rank(handle->comm, &(handle->mpi_rank));
+    handle->bcast_attributes = false;
+    handle->agg_comm = MPI_COMM_NULL;
+    handle->node_comm = MPI_COMM_NULL;
 
     handle->transfer_mode = H5Pcreate(H5P_DATASET_XFER);
     H5Pset_dxpl_mpio(handle->transfer_mode, H5FD_MPIO_COLLECTIVE);
 
-    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
+    if ((fapl_id = _create_fapl_mpi(comm, info)) < 0) {
         H5Pclose(handle->transfer_mode);
         free(handle);
         DEFER_FUNC_ERROR(fapl_id);
         return NULL;
     }
-    if ((err = H5Pset_fapl_mpio(fapl_id, comm, MPI_INFO_NULL)) < 0) {
-        H5Pclose(handle->transfer_mode);
-        H5Pclose(fapl_id);
-        free(handle);
-        DEFER_FUNC_ERROR(fapl_id);
-        return NULL;
-    }
 
     if ((handle->file_id = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id)) < 0) {
         H5Pclose(handle->transfer_mode);
         H5Pclose(fapl_id);
-        free(handle);
         DEFER_FUNC_ERROR(handle->file_id);
-    };
+        free(handle);
+        return NULL;
+    }
     H5Pclose(fapl_id);
 
     if (_create_root(handle, path) != ESCDF_SUCCESS) {
@@ -187,10 +262,110 @@ escdf_handle_t * escdf_open_mpi(const char *filename, const char *path,
 }
 #endif
 
+#ifdef HAVE_MPI
+escdf_errno_t escdf_handle_set_broadcast_attributes(escdf_handle_t *handle, bool bcast_attributes)
+{
+    FULFILL_OR_RETURN(handle != NULL, ESCDF_EOBJECT);
+
+    handle->bcast_attributes = bcast_attributes;
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_handle_set_aggregation(escdf_handle_t *handle, int group_size)
+{
+    FULFILL_OR_RETURN(handle != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(group_size >= ESCDF_AGGREGATION_NODE, ESCDF_ERANGE);
+
+    if (handle->agg_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&handle->agg_comm);
+    }
+    if (handle->mpi_size == 1) {
+        return ESCDF_SUCCESS;
+    }
+
+    /* Groups keep the rank order, the writers merging the contiguous
+       slices of their members from their offsets. */
+    if (group_size == ESCDF_AGGREGATION_NODE) {
+        MPI_Comm_split_type(handle->comm, MPI_COMM_TYPE_SHARED, handle->mpi_rank,
+                            MPI_INFO_NULL, &handle->agg_comm);
+    } else if (group_size > 1) {
+        MPI_Comm_split(handle->comm, handle->mpi_rank / group_size, handle->mpi_rank,
+                       &handle->agg_comm);
+    }
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t escdf_handle_set_node_sharing(escdf_handle_t *handle, bool node_sharing)
+{
+    FULFILL_OR_RETURN(handle != NULL, ESCDF_EOBJECT);
+
+    if (handle->node_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&handle->node_comm);
+    }
+    if (node_sharing) {
+        MPI_Comm_split_type(handle->comm, MPI_COMM_TYPE_SHARED, handle->mpi_rank,
+                            MPI_INFO_NULL, &handle->node_comm);
+    }
+
+    return ESCDF_SUCCESS;
+}
+#endif
+
+hid_t escdf_transfer_create(escdf_transfer_mode_t mode)
+{
+#ifdef HAVE_MPI
+    hid_t xfer_id;
+
+    if (mode == ESCDF_TRANSFER_DEFAULT) {
+        return H5P_DEFAULT;
+    }
+    if ((xfer_id = H5Pcreate(H5P_DATASET_XFER)) < 0) {
+        return xfer_id;
+    }
+    if (H5Pset_dxpl_mpio(xfer_id, (mode == ESCDF_TRANSFER_INDEPENDENT) ?
+                         H5FD_MPIO_INDEPENDENT : H5FD_MPIO_COLLECTIVE) < 0 ||
+        (mode == ESCDF_TRANSFER_COLLECTIVE_INDEPENDENT_IO &&
+         H5Pset_dxpl_mpio_collective_opt(xfer_id, H5FD_MPIO_INDIVIDUAL_IO) < 0)) {
+        H5Pclose(xfer_id);
+        return -1;
+    }
+    return xfer_id;
+#else
+    (void)mode;
+    return H5P_DEFAULT;
+#endif
+}
+
+escdf_errno_t escdf_handle_set_transfer_mode(escdf_handle_t *handle, escdf_transfer_mode_t mode)
+{
+    hid_t xfer_id;
+
+    FULFILL_OR_RETURN(handle != NULL, ESCDF_EOBJECT);
+    FULFILL_OR_RETURN(mode >= ESCDF_TRANSFER_DEFAULT && mode < ESCDF_N_TRANSFER_MODES, ESCDF_ERANGE);
+
+    FULFILL_OR_RETURN((xfer_id = escdf_transfer_create(mode)) >= 0, ESCDF_ERROR);
+    if (handle->transfer_mode != H5P_DEFAULT) {
+        H5Pclose(handle->transfer_mode);
+    }
+    handle->transfer_mode = xfer_id;
+
+    return ESCDF_SUCCESS;
+}
+
 escdf_errno_t escdf_close(escdf_handle_t *handle) {
     herr_t err;
 
     err = 0;
+#ifdef HAVE_MPI
+    if (handle->agg_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&handle->agg_comm);
+    }
+    if (handle->node_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&handle->node_comm);
+    }
+#endif
     if (handle->transfer_mode != H5P_DEFAULT) {
         DEFER_TEST_ERROR((err = H5Pclose(handle->transfer_mode)) < 0, err);
     }
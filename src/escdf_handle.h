@@ -27,6 +27,7 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <hdf5.h>
 
 #include "escdf_error.h"
@@ -46,6 +47,18 @@ extern "C" {
  * Data structures                                                            *
  ******************************************************************************/
 
+/**
+ * Data transfer modes, only meaningful for files opened with MPI-IO.
+ */
+typedef enum {
+    ESCDF_TRANSFER_DEFAULT = 0,  /**< HDF5 default, i.e. independent */
+    ESCDF_TRANSFER_INDEPENDENT,  /**< each rank accesses the file on its own */
+    ESCDF_TRANSFER_COLLECTIVE,   /**< all ranks take part in each transfer */
+    ESCDF_TRANSFER_COLLECTIVE_INDEPENDENT_IO, /**< collective call, independent
+                                                 I/O at the MPI-IO level */
+    ESCDF_N_TRANSFER_MODES
+} escdf_transfer_mode_t;
+
 /**
  * This handle is an abstract reference to an ESCDF file and all access to a file
  * through Libescdf is done through it.
@@ -63,6 +76,14 @@ typedef struct {
 
 #ifdef HAVE_MPI
     MPI_Comm comm;
+
+    bool bcast_attributes; /**< attributes are read by rank 0 and broadcast */
+
+    MPI_Comm agg_comm; /**< aggregation group, its rank 0 doing the writes,
+                          or MPI_COMM_NULL */
+
+    MPI_Comm node_comm; /**< ranks sharing a node, to read replicated
+                           datasets once per node, or MPI_COMM_NULL */
 #endif
 } escdf_handle_t;
 
@@ -98,12 +119,44 @@ escdf_handle_t * escdf_open(const char *filename, const char *path);
  */
 escdf_errno_t escdf_close(escdf_handle_t *handle);
 
+/**
+ * Creates a dataset transfer property list for the given mode. Without MPI
+ * support, or for ESCDF_TRANSFER_DEFAULT, H5P_DEFAULT is returned, otherwise
+ * the property list must be closed by the caller.
+ *
+ * @param[in] mode: the transfer mode.
+ * @return the property list identifier, negative on error.
+ */
+hid_t escdf_transfer_create(escdf_transfer_mode_t mode);
+
+/**
+ * Sets the transfer mode of the handle, used by all the data transfers that
+ * do not define their own, like the ones of grid scalarfields. Files opened
+ * with escdf_create_mpi() or escdf_open_mpi() are collective by default.
+ *
+ * @param[in,out] handle: the file handle.
+ * @param[in] mode: the transfer mode.
+ * @return error code.
+ */
+escdf_errno_t escdf_handle_set_transfer_mode(escdf_handle_t *handle, escdf_transfer_mode_t mode);
+
 
 #ifdef HAVE_MPI
 /**
  * Creates a file an returns a handle to it. ptionally, the root group is set to
  * 'path' if path is not NULL.
  *
+ * The file is accessed with the MPI-IO driver, collective data transfers and,
+ * with HDF5 >= 1.10, collective metadata operations: metadata is read once by
+ * one rank and broadcast, and written once. As a consequence, every call that
+ * reads or modifies metadata must be done by all the ranks of comm, with the
+ * same arguments. This covers escdf_group_open(), escdf_group_create(),
+ * escdf_group_close(), escdf_group_open_location(),
+ * escdf_group_create_location(), escdf_group_close_location(),
+ * escdf_group_read_attributes(), escdf_group_attribute_set(),
+ * escdf_group_query_datasets(), the opening, creation and closing of datasets
+ * and escdf_close().
+ *
  * @param[in] filename: the name of the file to be created.
  * @param[in] path: path for the root group inside the file.
  * @return instance of the handle.
@@ -114,11 +167,94 @@ escdf_handle_t * escdf_create_mpi(const char *filename, const char *path, MPI_Co
  * Opens a file an returns a handle to it. Optionally, consider the root group
  * to be given by 'path' if path is not NULL.
  *
+ * As for escdf_create_mpi(), metadata operations are collective on comm.
+ *
  * @param[in] filename: the name of the file to be created.
  * @param[in] path: path for the root group inside the file.
  * @return instance of the handle.
  */
 escdf_handle_t * escdf_open_mpi(const char *filename, const char *path, MPI_Comm comm);
+
+/**
+ * Same as escdf_create_mpi(), passing MPI-IO hints (file striping, collective
+ * buffering, ROMIO settings...) to the MPI-IO driver. In both cases, the
+ * hints can be overridden at run time with the ESCDF_MPI_HINTS environment
+ * variable, given as "key=value;key=value", e.g.
+ * ESCDF_MPI_HINTS="striping_factor=32;cb_nodes=16".
+ *
+ * @param[in] filename: the name of the file to be created.
+ * @param[in] path: path for the root group inside the file.
+ * @param[in] comm: the communicator of the ranks accessing the file.
+ * @param[in] info: the MPI-IO hints, or MPI_INFO_NULL.
+ * @return instance of the handle.
+ */
+escdf_handle_t * escdf_create_mpi_info(const char *filename, const char *path, MPI_Comm comm, MPI_Info info);
+
+/**
+ * Same as escdf_open_mpi(), passing MPI-IO hints to the MPI-IO driver, see
+ * escdf_create_mpi_info().
+ *
+ * @param[in] filename: the name of the file to be opened.
+ * @param[in] path: path for the root group inside the file.
+ * @param[in] comm: the communicator of the ranks accessing the file.
+ * @param[in] info: the MPI-IO hints, or MPI_INFO_NULL.
+ * @return instance of the handle.
+ */
+escdf_handle_t * escdf_open_mpi_info(const char *filename, const char *path, MPI_Comm comm, MPI_Info info);
+
+/**
+ * Sets whether group attributes are read by rank 0 only, packed in a single
+ * buffer and broadcast to the other ranks, in escdf_group_open() and
+ * escdf_group_read_attributes(). This replaces one metadata request per rank
+ * and per attribute by one broadcast per group. It defaults to false. It has
+ * no effect when the file uses collective metadata reads, as set up by
+ * escdf_create_mpi() and escdf_open_mpi() with HDF5 >= 1.10: HDF5 then
+ * already reads the attributes once and broadcasts them, and reads done by
+ * rank 0 alone would hang.
+ *
+ * @param[in,out] handle: the file handle.
+ * @param[in] bcast_attributes: true to read attributes on rank 0 only.
+ * @return error code.
+ */
+escdf_errno_t escdf_handle_set_broadcast_attributes(escdf_handle_t *handle, bool bcast_attributes);
+
+#define ESCDF_AGGREGATION_NONE 0   /**< every rank writes its own data */
+#define ESCDF_AGGREGATION_NODE -1  /**< one aggregator per node */
+
+/**
+ * Gathers the data written by groups of ranks on one aggregator rank per
+ * group, which then does the HDF5 writes on behalf of the group. This
+ * limits the number of ranks accessing the file, whatever the MPI-IO
+ * collective buffering settings. It applies to
+ * escdf_grid_scalarfield_write_values_on_grid_sliced() and
+ * escdf_dataset_write_aggregated().
+ *
+ * Groups are made of group_size consecutive ranks of the communicator,
+ * the first one being the aggregator. With ESCDF_AGGREGATION_NODE, groups
+ * are made of the ranks sharing a node, whatever their placement, the
+ * lowest one being the aggregator. The aggregator writes the slices of its
+ * group at their own offsets, merging the contiguous ones into single
+ * writes. ESCDF_AGGREGATION_NONE, the default, disables the aggregation.
+ * This is a collective call.
+ *
+ * @param[in,out] handle: the file handle.
+ * @param[in] group_size: the number of ranks per aggregator.
+ * @return error code.
+ */
+escdf_errno_t escdf_handle_set_aggregation(escdf_handle_t *handle, int group_size);
+
+/**
+ * Sets whether datasets read with escdf_dataset_read_shared() are read once
+ * per node, by one rank, into MPI shared memory, the other ranks of the node
+ * getting read-only access to it. This saves I/O requests and memory for
+ * data replicated on all ranks. It defaults to false. This is a collective
+ * call.
+ *
+ * @param[in,out] handle: the file handle.
+ * @param[in] node_sharing: true to share reads among the ranks of a node.
+ * @return error code.
+ */
+escdf_errno_t escdf_handle_set_node_sharing(escdf_handle_t *handle, bool node_sharing);
 #endif
 
 #ifdef __cplusplus
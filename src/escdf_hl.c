@@ -272,6 +272,74 @@ escdf_errno_t escdf_hl_dataset_read_simple(escdf_group_t *group, escdf_dataset_i
 }
 
 
+escdf_errno_t escdf_hl_dataset_append_frame(escdf_group_t *group, escdf_dataset_id_t dataset_ID, const void *buf)
+{
+    int index;
+    escdf_dataset_t *data;
+
+    FULFILL_OR_RETURN(group != NULL, ESCDF_ERROR);
+
+    index = _escdf_group_get_dataset_index(group, dataset_ID);
+    FULFILL_OR_RETURN(index >= 0, ESCDF_ERROR);
+
+    data = group->datasets[index];
+    if (data == NULL) {
+        if (utils_hdf5_check_present(group->loc_id, group->specs->data_specs[index]->name)) {
+            data = escdf_group_dataset_open(group, dataset_ID);
+        } else {
+            data = escdf_group_dataset_create_time_series(group, dataset_ID);
+        }
+    }
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_ERROR);
+    FULFILL_OR_RETURN(buf != NULL, ESCDF_ERROR);
+
+    FULFILL_OR_RETURN( escdf_dataset_append_frame(data, buf) == ESCDF_SUCCESS, ESCDF_ERROR);
+
+    return ESCDF_SUCCESS;
+}
+
+
+escdf_errno_t escdf_hl_dataset_read_frame(escdf_group_t *group, escdf_dataset_id_t dataset_ID, size_t frame, void *buf)
+{
+    int index;
+    const escdf_dataset_t *data;
+
+    FULFILL_OR_RETURN(group != NULL, ESCDF_ERROR);
+
+    index = _escdf_group_get_dataset_index(group, dataset_ID);
+    FULFILL_OR_RETURN(index >= 0, ESCDF_ERROR);
+
+    data = group->datasets[index];
+    if (data == NULL) {
+        data = escdf_group_dataset_open(group, dataset_ID);
+    }
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_ERROR);
+    FULFILL_OR_RETURN(buf != NULL, ESCDF_ERROR);
+
+    FULFILL_OR_RETURN( escdf_dataset_read_frame(data, frame, buf) == ESCDF_SUCCESS, ESCDF_ERROR);
+
+    return ESCDF_SUCCESS;
+}
+
+
+escdf_errno_t escdf_hl_dataset_read_points(escdf_group_t *group, escdf_dataset_id_t dataset_ID,
+                                           size_t num_points, const size_t *coord, void *buf)
+{
+    const escdf_dataset_t *data;
+
+    data = escdf_hl_dataset_open(group, dataset_ID);
+
+    FULFILL_OR_RETURN(data != NULL, ESCDF_ERROR);
+    FULFILL_OR_RETURN(buf != NULL || num_points == 0, ESCDF_ERROR);
+
+    FULFILL_OR_RETURN( escdf_dataset_read_points(data, num_points, coord, buf) == ESCDF_SUCCESS, ESCDF_ERROR);
+
+    return ESCDF_SUCCESS;
+}
+
+
 escdf_errno_t escdf_hl_dataset_write_at(escdf_group_t *group, escdf_dataset_id_t dataset_ID, 
                                         unsigned int *start, unsigned int *count, unsigned int * stride, void* buf);
 
@@ -149,6 +149,45 @@ escdf_errno_t escdf_hl_dataset_write_simple(escdf_group_t *group, escdf_dataset_
  */
 escdf_errno_t escdf_hl_dataset_read_simple(escdf_group_t *group, escdf_dataset_id_t dataset_ID, void *buf);
 
+/**
+ * @brief Append one frame to a time series dataset
+ * 
+ * On first use, the dataset is opened if present in the file, or
+ * created as an empty time series otherwise. It is then kept open, so
+ * that a trajectory can be written one frame per step into the same
+ * group.
+ * 
+ * @param group 
+ * @param[in] dataset_ID 
+ * @param[in] buf: values of one frame
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_hl_dataset_append_frame(escdf_group_t *group, escdf_dataset_id_t dataset_ID, const void *buf);
+
+/**
+ * @brief Read one frame of a time series dataset
+ * 
+ * @param group 
+ * @param[in] dataset_ID 
+ * @param[in] frame: index of the frame
+ * @param[out] buf: values of the frame
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_hl_dataset_read_frame(escdf_group_t *group, escdf_dataset_id_t dataset_ID, size_t frame, void *buf);
+
+/**
+ * @brief Read scattered elements of a dataset
+ * 
+ * @param group 
+ * @param[in] dataset_ID 
+ * @param[in] num_points: number of elements to read
+ * @param[in] coord: indices of the elements, num_points times the rank of the dataset
+ * @param[out] buf: values, in the order of the points
+ * @return escdf_errno_t 
+ */
+escdf_errno_t escdf_hl_dataset_read_points(escdf_group_t *group, escdf_dataset_id_t dataset_ID,
+                                           size_t num_points, const size_t *coord, void *buf);
+
 /**
  * @brief Write a section of a dataset
  * 
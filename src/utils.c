@@ -19,6 +19,9 @@
  * 02110-1301  USA.
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "utils.h"
 
 
@@ -57,3 +60,39 @@ _double_set_t _double_set(const double value)
     result.is_set = true;
     return result;
 }
+
+
+/******************************************************************************
+ * MPI helpers                                                                *
+ ******************************************************************************/
+
+#ifdef HAVE_MPI
+void _gather_bytes(const void *buf, size_t nbytes, void *gbuf,
+                   const size_t *counts, const size_t *displs, MPI_Comm comm)
+{
+    int rank, size, g, piece;
+    size_t done;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    if (rank != 0) {
+        for (done = 0; done < nbytes; done += piece) {
+            piece = (nbytes - done > INT_MAX) ? INT_MAX : (int)(nbytes - done);
+            MPI_Send((const char *)buf + done, piece, MPI_BYTE, 0, 0, comm);
+        }
+        return;
+    }
+
+    if (nbytes > 0) {
+        memcpy((char *)gbuf + displs[0], buf, nbytes);
+    }
+    for (g = 1; g < size; g++) {
+        for (done = 0; done < counts[g]; done += piece) {
+            piece = (counts[g] - done > INT_MAX) ? INT_MAX : (int)(counts[g] - done);
+            MPI_Recv((char *)gbuf + displs[g] + done, piece, MPI_BYTE, g, 0, comm,
+                     MPI_STATUS_IGNORE);
+        }
+    }
+}
+#endif
@@ -23,6 +23,13 @@
 #define LIBESCDF_UTILS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include "config.h"
+
+#ifdef HAVE_MPI_H
+#include <mpi.h>
+#endif
 
 /******************************************************************************
  * Data structures                                                            *
@@ -75,4 +82,27 @@ _int_set_t _int_set(const int value);
 
 _double_set_t _double_set(const double value);
 
+
+/******************************************************************************
+ * MPI helpers                                                                *
+ ******************************************************************************/
+
+#ifdef HAVE_MPI
+/**
+ * Gathers on rank 0 of comm the nbytes bytes of buf of every rank, those of
+ * rank g being stored at gbuf + displs[g]. Contrary to MPI_Gatherv(), sizes
+ * and offsets are not limited to int, messages being sent by pieces of at
+ * most INT_MAX bytes.
+ *
+ * @param[in] buf: the local bytes.
+ * @param[in] nbytes: the number of local bytes.
+ * @param[out] gbuf: the gathered bytes, only used on rank 0.
+ * @param[in] counts: the number of bytes of every rank, only used on rank 0.
+ * @param[in] displs: the offsets in gbuf of every rank, only used on rank 0.
+ * @param[in] comm: the communicator.
+ */
+void _gather_bytes(const void *buf, size_t nbytes, void *gbuf,
+                   const size_t *counts, const size_t *displs, MPI_Comm comm);
+#endif
+
 #endif
@@ -180,6 +180,45 @@ escdf_errno_t utils_hdf5_check_dataset(hid_t loc_id, const char *name, const siz
     return ESCDF_ERROR;
 }
 
+escdf_errno_t utils_hdf5_get_frames(hid_t dtset_id, bool *has_frames, size_t *nframes)
+{
+    hid_t dtspace_id;
+    int ndims;
+    hsize_t *dims, *maxdims;
+
+    *has_frames = false;
+    *nframes = 0;
+
+    if ((dtspace_id = H5Dget_space(dtset_id)) < 0)
+        RETURN_WITH_ERROR(dtspace_id);
+    if ((ndims = H5Sget_simple_extent_ndims(dtspace_id)) < 0) {
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ndims);
+    }
+    if (ndims == 0) {
+        H5Sclose(dtspace_id);
+        return ESCDF_SUCCESS;
+    }
+
+    dims = malloc(sizeof(hsize_t) * ndims);
+    maxdims = malloc(sizeof(hsize_t) * ndims);
+    if (H5Sget_simple_extent_dims(dtspace_id, dims, maxdims) < 0) {
+        free(dims);
+        free(maxdims);
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    if (maxdims[0] == H5S_UNLIMITED) {
+        *has_frames = true;
+        *nframes = dims[0];
+    }
+    free(dims);
+    free(maxdims);
+    H5Sclose(dtspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
 
 /******************************************************************************
  * read methods                                                               *
@@ -409,13 +448,143 @@ escdf_errno_t utils_hdf5_read_dataset(hid_t dtset_id, hid_t xfer_id, void *buf,
     return ESCDF_SUCCESS;
 }
 
+/* The disk selection of the _mem functions: a single hyperslab is a
+   box, and the whole dataset is selected without one. */
+static escdf_errno_t _select_hyperslab(hid_t dtset_id, hid_t *diskspace_id, hid_t *memspace_id,
+                                       const hsize_t *start, const hsize_t *count, const hsize_t *stride)
+{
+    if (start && count) {
+        return utils_hdf5_select_boxes(dtset_id, diskspace_id, memspace_id, 1, start, count, stride);
+    }
+    return utils_hdf5_select_slice(dtset_id, diskspace_id, memspace_id, NULL, NULL, NULL);
+}
+
+escdf_errno_t utils_hdf5_read_dataset_mem(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                          const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                          const hsize_t *mem_dims, unsigned int mem_ndims,
+                                          const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride)
+{
+    escdf_errno_t err;
+    hid_t memspace_id, diskspace_id, xfer_plist;
+    herr_t err_id;
+
+    if ((err = _select_hyperslab(dtset_id, &diskspace_id, &memspace_id,
+                                 start, count, stride)) != ESCDF_SUCCESS) {
+        return err;
+    }
+
+    if (mem_dims != NULL) {
+        H5Sclose(memspace_id);
+        if ((err = utils_hdf5_select_mem_slice(&memspace_id, H5Sget_select_npoints(diskspace_id),
+                                               mem_dims, mem_ndims,
+                                               mem_start, mem_count, mem_stride)) != ESCDF_SUCCESS) {
+            H5Sclose(diskspace_id);
+            return err;
+        }
+    }
+
+    if(xfer_id != ESCDF_UNDEFINED_ID)
+        xfer_plist = xfer_id;
+    else
+        xfer_plist = H5P_DEFAULT;
+
+    /* Read */
+    if ((err_id = H5Dread(dtset_id, mem_type_id, memspace_id,
+                          diskspace_id, xfer_plist, buf)) < 0) {
+        H5Sclose(diskspace_id);
+        H5Sclose(memspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    H5Sclose(diskspace_id);
+    H5Sclose(memspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t utils_hdf5_read_dataset_boxes_mem(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                                size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                                const hsize_t *mem_dims, unsigned int mem_ndims,
+                                                const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride)
+{
+    escdf_errno_t err;
+    hid_t memspace_id, diskspace_id, xfer_plist;
+    herr_t err_id;
+
+    if (mem_dims == NULL) {
+        return utils_hdf5_read_dataset_boxes(dtset_id, xfer_id, buf, mem_type_id, nboxes, start, count, stride);
+    }
+
+    if ((err = utils_hdf5_select_boxes(dtset_id, &diskspace_id, &memspace_id,
+                                       nboxes, start, count, stride)) != ESCDF_SUCCESS) {
+        return err;
+    }
+    H5Sclose(memspace_id);
+
+    if ((err = utils_hdf5_select_mem_slice(&memspace_id, H5Sget_select_npoints(diskspace_id),
+                                           mem_dims, mem_ndims,
+                                           mem_start, mem_count, mem_stride)) != ESCDF_SUCCESS) {
+        H5Sclose(diskspace_id);
+        return err;
+    }
+
+    if(xfer_id != ESCDF_UNDEFINED_ID)
+        xfer_plist = xfer_id;
+    else
+        xfer_plist = H5P_DEFAULT;
+
+    /* Read */
+    if ((err_id = H5Dread(dtset_id, mem_type_id, memspace_id,
+                          diskspace_id, xfer_plist, buf)) < 0) {
+        H5Sclose(diskspace_id);
+        H5Sclose(memspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    H5Sclose(diskspace_id);
+    H5Sclose(memspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t utils_hdf5_read_dataset_boxes(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                            size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride)
+{
+    escdf_errno_t err;
+    hid_t memspace_id, diskspace_id, xfer_plist;
+    herr_t err_id;
+
+    if ((err = utils_hdf5_select_boxes(dtset_id, &diskspace_id, &memspace_id,
+                                       nboxes, start, count, stride)) != ESCDF_SUCCESS) {
+        return err;
+    }
+
+    if(xfer_id != ESCDF_UNDEFINED_ID)
+        xfer_plist = xfer_id;
+    else
+        xfer_plist = H5P_DEFAULT;
+
+    /* Read */
+    if ((err_id = H5Dread(dtset_id, mem_type_id, memspace_id,
+                          diskspace_id, xfer_plist, buf)) < 0) {
+        H5Sclose(diskspace_id);
+        H5Sclose(memspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    H5Sclose(diskspace_id);
+    H5Sclose(memspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
 escdf_errno_t utils_hdf5_read_dataset_at(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id, const size_t num_points, const size_t *coord)
 {
-    hid_t memspace_id, diskspace_id;
+    hid_t memspace_id, diskspace_id, xfer_plist;
     herr_t err_id;
     hsize_t len;
-    hsize_t coord_[2*num_points];
-    unsigned int i;
+    hsize_t *coord_;
+    size_t i, ndims;
 
     if(num_points > 0 && coord == NULL) {
         RETURN_WITH_ERROR(ESCDF_ERROR);
@@ -426,13 +595,17 @@ escdf_errno_t utils_hdf5_read_dataset_at(hid_t dtset_id, hid_t xfer_id, void *bu
         RETURN_WITH_ERROR(diskspace_id);
     }
 
-    for (i=0; i<2*num_points; i++) {
-        coord_[i] = coord[i];
-    }
-
     if (num_points) {
-        if ((err_id = H5Sselect_elements(diskspace_id, H5S_SELECT_SET,
-                                         num_points, coord_)) < 0) {
+        /* coord holds one set of indices per point, of the rank of the dataset. */
+        ndims = H5Sget_simple_extent_ndims(diskspace_id);
+        coord_ = (hsize_t*) malloc(ndims * num_points * sizeof(hsize_t));
+        for (i=0; i<ndims*num_points; i++) {
+            coord_[i] = coord[i];
+        }
+        err_id = H5Sselect_elements(diskspace_id, H5S_SELECT_SET,
+                                    num_points, coord_);
+        free(coord_);
+        if (err_id < 0) {
             H5Sclose(diskspace_id);
             RETURN_WITH_ERROR(err_id);
         }
@@ -452,9 +625,14 @@ escdf_errno_t utils_hdf5_read_dataset_at(hid_t dtset_id, hid_t xfer_id, void *bu
         RETURN_WITH_ERROR(memspace_id);
     }
 
+    if(xfer_id != ESCDF_UNDEFINED_ID)
+        xfer_plist = xfer_id;
+    else
+        xfer_plist = H5P_DEFAULT;
+
     /* Read */
     if ((err_id = H5Dread(dtset_id, mem_type_id, memspace_id,
-                          diskspace_id, xfer_id, buf)) < 0) {
+                          diskspace_id, xfer_plist, buf)) < 0) {
         H5Sclose(diskspace_id);
         H5Sclose(memspace_id);
         RETURN_WITH_ERROR(err_id);
@@ -542,6 +720,11 @@ escdf_errno_t utils_hdf5_create_attr(hid_t loc_id, const char *name, hid_t type_
 }
 
 escdf_errno_t utils_hdf5_create_dataset(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t *dtset_pt)
+{
+    return utils_hdf5_create_dataset_dcpl(loc_id, name, type_id, dims, ndims, H5P_DEFAULT, dtset_pt);
+}
+
+escdf_errno_t utils_hdf5_create_dataset_dcpl(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t dcpl_id, hid_t *dtset_pt)
 {
     unsigned int i;
     hid_t dtset_id, dtspace_id;
@@ -561,7 +744,7 @@ escdf_errno_t utils_hdf5_create_dataset(hid_t loc_id, const char *name, hid_t ty
         RETURN_WITH_ERROR(dtspace_id);
     }
 
-    if ((dtset_id = H5Dcreate(loc_id, name, type_id, dtspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+    if ((dtset_id = H5Dcreate(loc_id, name, type_id, dtspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT)) < 0) {
         DEFER_FUNC_ERROR(dtset_id);
         goto cleanup_dtspace;
     }
@@ -587,6 +770,47 @@ escdf_errno_t utils_hdf5_create_dataset(hid_t loc_id, const char *name, hid_t ty
     return ESCDF_ERROR;
 }
 
+escdf_errno_t utils_hdf5_create_dataset_frames(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t *dtset_pt)
+{
+    unsigned int i;
+    hid_t dtset_id, dtspace_id, dcpl_id;
+    hsize_t dims_[ndims + 1], maxdims_[ndims + 1], chunk_[ndims + 1];
+
+    /* Empty leading dimension, one chunk per frame. */
+    dims_[0] = 0;
+    maxdims_[0] = H5S_UNLIMITED;
+    chunk_[0] = 1;
+    for (i = 0; i < ndims; i++) {
+        dims_[i + 1] = dims[i];
+        maxdims_[i + 1] = dims[i];
+        chunk_[i + 1] = (dims[i] > 0) ? dims[i] : 1;
+    }
+
+    if ((dtspace_id = H5Screate_simple(ndims + 1, dims_, maxdims_)) < 0)
+        RETURN_WITH_ERROR(dtspace_id);
+    if ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0) {
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(dcpl_id);
+    }
+    if (H5Pset_chunk(dcpl_id, ndims + 1, chunk_) < 0) {
+        H5Pclose(dcpl_id);
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    dtset_id = H5Dcreate(loc_id, name, type_id, dtspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+    H5Pclose(dcpl_id);
+    H5Sclose(dtspace_id);
+    if (dtset_id < 0)
+        RETURN_WITH_ERROR(dtset_id);
+
+    if (dtset_pt)
+        *dtset_pt = dtset_id;
+    else
+        H5Dclose(dtset_id);
+    return ESCDF_SUCCESS;
+}
+
 
 /******************************************************************************
  * write methods                                                              *
@@ -691,6 +915,126 @@ escdf_errno_t utils_hdf5_write_dataset(hid_t dtset_id, hid_t xfer_id, const void
 }
 
 
+escdf_errno_t utils_hdf5_write_dataset_boxes(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id,
+                                             size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride)
+{
+    escdf_errno_t err;
+    hid_t memspace_id, diskspace_id, xfer_plist;
+    herr_t err_id;
+
+    err = utils_hdf5_select_boxes(dtset_id, &diskspace_id, &memspace_id,
+                                  nboxes, start, count, stride);
+    FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+
+    if( xfer_id != ESCDF_UNDEFINED_ID ) {
+        xfer_plist = xfer_id;
+    } else {
+        xfer_plist = H5P_DEFAULT;
+    }
+
+    /* Write */
+    if ((err_id = H5Dwrite(dtset_id, mem_type_id, memspace_id,
+                           diskspace_id, xfer_plist, buf)) < 0) {
+        H5Sclose(diskspace_id);
+        H5Sclose(memspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    H5Sclose(diskspace_id);
+    H5Sclose(memspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t utils_hdf5_write_dataset_mem(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id,
+                                           const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                           const hsize_t *mem_dims, unsigned int mem_ndims,
+                                           const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride)
+{
+    escdf_errno_t err;
+    hid_t memspace_id, diskspace_id, xfer_plist;
+    herr_t err_id;
+
+    err = _select_hyperslab(dtset_id, &diskspace_id, &memspace_id,
+                            start, count, stride);
+    FULFILL_OR_RETURN(err == ESCDF_SUCCESS, err);
+
+    if (mem_dims != NULL) {
+        H5Sclose(memspace_id);
+        if ((err = utils_hdf5_select_mem_slice(&memspace_id, H5Sget_select_npoints(diskspace_id),
+                                               mem_dims, mem_ndims,
+                                               mem_start, mem_count, mem_stride)) != ESCDF_SUCCESS) {
+            H5Sclose(diskspace_id);
+            return err;
+        }
+    }
+
+    if( xfer_id != ESCDF_UNDEFINED_ID ) {
+        xfer_plist = xfer_id;
+    } else {
+        xfer_plist = H5P_DEFAULT;
+    }
+
+    /* Write */
+    if ((err_id = H5Dwrite(dtset_id, mem_type_id, memspace_id,
+                           diskspace_id, xfer_plist, buf)) < 0) {
+        H5Sclose(diskspace_id);
+        H5Sclose(memspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    H5Sclose(diskspace_id);
+    H5Sclose(memspace_id);
+
+    return ESCDF_SUCCESS;
+}
+
+
+escdf_errno_t utils_hdf5_append_frame(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id, size_t *frame)
+{
+    escdf_errno_t err;
+    hid_t dtspace_id;
+    int ndims, i;
+    hsize_t *dims;
+    size_t *start, *count;
+
+    if ((dtspace_id = H5Dget_space(dtset_id)) < 0)
+        RETURN_WITH_ERROR(dtspace_id);
+    if ((ndims = H5Sget_simple_extent_ndims(dtspace_id)) <= 0) {
+        H5Sclose(dtspace_id);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    dims = malloc(sizeof(hsize_t) * ndims);
+    H5Sget_simple_extent_dims(dtspace_id, dims, NULL);
+    H5Sclose(dtspace_id);
+
+    /* Grow the leading dimension by one frame. */
+    dims[0] += 1;
+    if (H5Dset_extent(dtset_id, dims) < 0) {
+        free(dims);
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    start = malloc(sizeof(size_t) * ndims);
+    count = malloc(sizeof(size_t) * ndims);
+    start[0] = dims[0] - 1;
+    count[0] = 1;
+    for (i = 1; i < ndims; i++) {
+        start[i] = 0;
+        count[i] = dims[i];
+    }
+    err = utils_hdf5_write_dataset(dtset_id, xfer_id, buf, mem_type_id, start, count, NULL);
+    if (err == ESCDF_SUCCESS && frame) {
+        *frame = start[0];
+    }
+    free(start);
+    free(count);
+    free(dims);
+
+    return err;
+}
+
+
 /******************************************************************************
  * dataset open methods                                                       *
  ******************************************************************************/
@@ -706,6 +1050,44 @@ escdf_errno_t utils_hdf5_open_dataset(hid_t loc_id, const char *name, hid_t *dts
     return ESCDF_SUCCESS;
 }
 
+#ifdef HAVE_MPI
+escdf_errno_t utils_hdf5_open_dataset_independent(hid_t dtset_id, hid_t *dtset_pt)
+{
+    hid_t file_id, dapl_id;
+    ssize_t len;
+    char *name;
+
+    if ((len = H5Iget_name(dtset_id, NULL, 0)) <= 0) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+    if ((name = malloc(len + 1)) == NULL) {
+        RETURN_WITH_ERROR(ESCDF_ENOMEM);
+    }
+    H5Iget_name(dtset_id, name, len + 1);
+    if ((file_id = H5Iget_file_id(dtset_id)) < 0) {
+        free(name);
+        RETURN_WITH_ERROR(file_id);
+    }
+    if ((dapl_id = H5Pcreate(H5P_DATASET_ACCESS)) < 0) {
+        H5Fclose(file_id);
+        free(name);
+        RETURN_WITH_ERROR(dapl_id);
+    }
+#if H5_VERSION_GE(1, 10, 0)
+    H5Pset_all_coll_metadata_ops(dapl_id, false);
+#endif
+    *dtset_pt = H5Dopen2(file_id, name, dapl_id);
+    H5Pclose(dapl_id);
+    H5Fclose(file_id);
+    free(name);
+    if (*dtset_pt < 0) {
+        RETURN_WITH_ERROR(ESCDF_ERROR);
+    }
+
+    return ESCDF_SUCCESS;
+}
+#endif
+
 escdf_errno_t utils_hdf5_close_dataset(hid_t dtset_id)
 {
     herr_t err;
@@ -821,6 +1203,112 @@ escdf_errno_t utils_hdf5_select_slice(hid_t dtset_id, hid_t *diskspace_id, hid_t
     return ESCDF_SUCCESS;
 }
 
+escdf_errno_t utils_hdf5_select_boxes(hid_t dtset_id, hid_t *diskspace_id, hid_t *memspace_id,
+                                      size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride)
+{
+    herr_t err_id;
+    hssize_t len;
+    hsize_t len_, nexpected, nbox;
+    unsigned int i, ndims;
+    size_t ibox;
+
+    FULFILL_OR_RETURN(nboxes == 0 || (start != NULL && count != NULL), ESCDF_EVALUE);
+
+    if ((*diskspace_id = H5Dget_space(dtset_id)) < 0) {
+        RETURN_WITH_ERROR(*diskspace_id);
+    }
+    if ((err_id = H5Sselect_none(*diskspace_id)) < 0) {
+        H5Sclose(*diskspace_id);
+        RETURN_WITH_ERROR(err_id);
+    }
+
+    ndims = H5Sget_simple_extent_ndims(*diskspace_id);
+
+    /* Build the union of all boxes on disk. */
+    nexpected = 0;
+    for (ibox = 0; ibox < nboxes; ibox++) {
+        nbox = 1;
+        for (i = 0; i < ndims; i++) {
+            nbox *= count[ibox * ndims + i];
+        }
+        nexpected += nbox;
+        if (!nbox) {
+            continue;
+        }
+        if ((err_id = H5Sselect_hyperslab(*diskspace_id, H5S_SELECT_OR,
+                                          start + ibox * ndims,
+                                          (stride != NULL) ? stride + ibox * ndims : NULL,
+                                          count + ibox * ndims, NULL)) < 0) {
+            H5Sclose(*diskspace_id);
+            RETURN_WITH_ERROR(err_id);
+        }
+    }
+
+    if ((len = H5Sget_select_npoints(*diskspace_id)) < 0) {
+        H5Sclose(*diskspace_id);
+        RETURN_WITH_ERROR(len);
+    }
+    /* Overlapping boxes would silently shrink the selection. */
+    if ((hsize_t)len != nexpected) {
+        H5Sclose(*diskspace_id);
+        RETURN_WITH_ERROR(ESCDF_EVALUE);
+    }
+
+    if (len > 0) {
+        len_ = (hsize_t)len;
+        /* memory is a flat array with the size of the union. */
+        *memspace_id = H5Screate_simple(1, &len_, NULL);
+    } else {
+        *memspace_id = H5Screate(H5S_NULL);
+    }
+    if (*memspace_id < 0) {
+        H5Sclose(*diskspace_id);
+        RETURN_WITH_ERROR(*memspace_id);
+    }
+
+    return ESCDF_SUCCESS;
+}
+
+escdf_errno_t utils_hdf5_select_mem_slice(hid_t *memspace_id, hssize_t npoints,
+                                          const hsize_t *mem_dims, unsigned int mem_ndims,
+                                          const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride)
+{
+    herr_t err_id;
+    hssize_t len;
+
+    FULFILL_OR_RETURN(mem_dims != NULL && mem_ndims > 0, ESCDF_EVALUE);
+
+    *memspace_id = H5Screate_simple(mem_ndims, mem_dims, NULL);
+    if (*memspace_id < 0) {
+        RETURN_WITH_ERROR(*memspace_id);
+    }
+
+    if (mem_start && mem_count) {
+        if ((err_id = H5Sselect_hyperslab(*memspace_id, H5S_SELECT_SET,
+                                          mem_start, mem_stride, mem_count, NULL)) < 0) {
+            H5Sclose(*memspace_id);
+            RETURN_WITH_ERROR(err_id);
+        }
+    }
+
+    if ((len = H5Sget_select_npoints(*memspace_id)) < 0) {
+        H5Sclose(*memspace_id);
+        RETURN_WITH_ERROR(len);
+    }
+    if (len != npoints) {
+        H5Sclose(*memspace_id);
+        RETURN_WITH_ERROR(ESCDF_ESIZE);
+    }
+    if (!len) {
+        if ((err_id = H5Sselect_none(*memspace_id)) < 0) {
+            H5Sclose(*memspace_id);
+            RETURN_WITH_ERROR(err_id);
+        }
+    }
+
+    return ESCDF_SUCCESS;
+}
+
 hid_t utils_hdf5_mem_type(int datatype)
 {
     switch (datatype) {
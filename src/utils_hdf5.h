@@ -100,6 +100,17 @@ escdf_errno_t utils_hdf5_check_attr(hid_t loc_id, const char *name, const size_t
 /* OLD: escdf_errno_t utils_hdf5_check_dataset(hid_t loc_id, const char *name, const hsize_t *dims, unsigned int ndims, hid_t *dtset_pt); */
 escdf_errno_t utils_hdf5_check_dataset(hid_t loc_id, const char *name, const size_t *dims, unsigned int ndims, hid_t *dtset_pt);
 
+/**
+ * Checks whether a dataset has been created with utils_hdf5_create_dataset_frames(),
+ * i.e. has an unlimited leading dimension, and returns its current number of frames.
+ *
+ * @param[in] dtset_id: dataset identifier.
+ * @param[out] has_frames: true if the leading dimension is unlimited.
+ * @param[out] nframes: the current size of the leading dimension (0 if has_frames is false).
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_get_frames(hid_t dtset_id, bool *has_frames, size_t *nframes);
+
 
 /******************************************************************************
  * read methods                                                               *
@@ -238,6 +249,25 @@ escdf_errno_t utils_hdf5_read_dbl_array(hid_t loc_id, const char *name, double *
 /* OLD: escdf_errno_t utils_hdf5_read_dataset(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id, const hsize_t *start, const hsize_t *count, const hsize_t *stride); */
 escdf_errno_t utils_hdf5_read_dataset(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id, const size_t *start, const size_t *count, const size_t *stride); 
 
+/**
+ * Reads the union of several hyperslices of a dataset into a buffer, with a single read operation. The boxes are
+ * given as nboxes consecutive sets of start, count and stride values, each of the rank of the dataset. The boxes must
+ * be disjoint. The values are stored in the buffer following the row-major order of the dataset over the union of
+ * the boxes, not box after box.
+ *
+ * @param[in] dtset_id: identifier of the dataset to read from.
+ * @param[in] xfer_id: identifier of a transfer property list for this I/O operation.
+ * @param[out] buf: buffer for data to be read.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[in] nboxes: number of boxes.
+ * @param[in] start: offsets of start of each box, nboxes times the rank of the dataset.
+ * @param[in] count: number of blocks included in each box.
+ * @param[in] stride: stride of each box, may be NULL.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_read_dataset_boxes(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                            size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride);
+
 /**
  * Reads selected array elements from a dataset into a buffer.
  *
@@ -246,13 +276,63 @@ escdf_errno_t utils_hdf5_read_dataset(hid_t dtset_id, hid_t xfer_id, void *buf,
  * @param[out] buf: buffer for data to be read.
  * @param[in] mem_type_id: identifier of the memory datatype.
  * @param[in] num_points: number of elements to be selected.
- * @param[in] coord: a pointer to a buffer containing a serialized copy of a 2-dimensional array of zero-based values
- *                   specifying the coordinates of the elements in the point selection.
+ * @param[in] coord: a pointer to a buffer containing a serialized copy of a num_points x rank array of zero-based
+ *                   values specifying the coordinates of the elements in the point selection.
  * @return error code.
  */
 /* OLD: escdf_errno_t utils_hdf5_read_dataset_at(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id, hsize_t num_points, const hsize_t *coord); */
 escdf_errno_t utils_hdf5_read_dataset_at(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id, const size_t num_points, const size_t *coord); 
 
+/**
+ * Reads a hyperslice of a dataset into a hyperslice of a larger memory buffer. The memory buffer is described as a
+ * dense array of shape mem_dims, and the data is placed in the region defined by mem_start, mem_count and
+ * mem_stride. Both selections must have the same number of elements. If mem_dims is NULL, this is equivalent to
+ * utils_hdf5_read_dataset().
+ *
+ * @param[in] dtset_id: identifier of the dataset to read from.
+ * @param[in] xfer_id: identifier of a transfer property list for this I/O operation.
+ * @param[out] buf: buffer for data to be read.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[in] start: offset of start of hyperslab on disk.
+ * @param[in] count: number of blocks included in hyperslab on disk.
+ * @param[in] stride: hyperslab stride on disk.
+ * @param[in] mem_dims: shape of the memory buffer.
+ * @param[in] mem_ndims: number of dimensions of the memory buffer.
+ * @param[in] mem_start: offset of start of hyperslab in memory.
+ * @param[in] mem_count: number of blocks included in hyperslab in memory.
+ * @param[in] mem_stride: hyperslab stride in memory.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_read_dataset_mem(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                          const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                          const hsize_t *mem_dims, unsigned int mem_ndims,
+                                          const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride);
+
+/**
+ * Reads the union of several disjoint hyperslices of a dataset, as utils_hdf5_read_dataset_boxes(), into a
+ * hyperslice of a larger memory buffer, as utils_hdf5_read_dataset_mem(). The values are placed in the memory
+ * region following the row-major order of the dataset over the union of the boxes.
+ *
+ * @param[in] dtset_id: identifier of the dataset to read from.
+ * @param[in] xfer_id: identifier of a transfer property list for this I/O operation.
+ * @param[out] buf: buffer for data to be read.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[in] nboxes: number of boxes.
+ * @param[in] start: offsets of start of each box, nboxes times the rank of the dataset.
+ * @param[in] count: number of blocks included in each box.
+ * @param[in] stride: stride of each box, may be NULL.
+ * @param[in] mem_dims: shape of the memory buffer.
+ * @param[in] mem_ndims: number of dimensions of the memory buffer.
+ * @param[in] mem_start: offset of start of hyperslab in memory.
+ * @param[in] mem_count: number of blocks included in hyperslab in memory.
+ * @param[in] mem_stride: hyperslab stride in memory.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_read_dataset_boxes_mem(hid_t dtset_id, hid_t xfer_id, void *buf, hid_t mem_type_id,
+                                                size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                                const hsize_t *mem_dims, unsigned int mem_ndims,
+                                                const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride);
+
 
 /******************************************************************************
  * create methods                                                             *
@@ -299,6 +379,37 @@ escdf_errno_t utils_hdf5_create_attr(hid_t loc_id, const char *name, hid_t type_
 /* OLD: escdf_errno_t utils_hdf5_create_dataset(hid_t loc_id, const char *name, hid_t type_id, const hsize_t *dims, unsigned int ndims, hid_t *dtset_pt); */
 escdf_errno_t utils_hdf5_create_dataset(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t *dtset_pt);
 
+/**
+ * Same as utils_hdf5_create_dataset(), with a dataset creation property list, e.g. to set a chunked layout.
+ *
+ * @param[in] loc_id: object identifier to which the dataset is to be attached to.
+ * @param[in] name: dataset name.
+ * @param[in] type_id: identifier of datatype for dataset.
+ * @param[in] dims: pointer to array storing the size of each dimension.
+ * @param[in] ndims: number of dimensions of the dataset.
+ * @param[in] dcpl_id: identifier of the dataset creation property list, or H5P_DEFAULT.
+ * @param[out] dtset_pt: if NULL the access to dataset is terminated on exit; otherwise returns a pointer to the dataset
+ *                       object identifier.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_create_dataset_dcpl(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t dcpl_id, hid_t *dtset_pt);
+
+/**
+ * Creates an empty dataset of frames: its shape is [nframes, dims], with an
+ * unlimited leading dimension and one chunk per frame, so that frames can be
+ * appended with utils_hdf5_append_frame() without rewriting the existing ones.
+ *
+ * @param[in] loc_id: object identifier to which the dataset is to be attached to.
+ * @param[in] name: dataset name.
+ * @param[in] type_id: identifier of datatype for dataset.
+ * @param[in] dims: pointer to array storing the size of each dimension of one frame.
+ * @param[in] ndims: number of dimensions of one frame.
+ * @param[out] dtset_pt: if NULL the access to dataset is terminated on exit; otherwise returns a pointer to the dataset
+ *                       object identifier.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_create_dataset_frames(hid_t loc_id, const char *name, hid_t type_id, const size_t *dims, unsigned int ndims, hid_t *dtset_pt);
+
 
 /******************************************************************************
  * write methods                                                              *
@@ -366,6 +477,59 @@ escdf_errno_t utils_hdf5_write_attr_string(hid_t loc_id, const char *name, hsize
 /* OLD: escdf_errno_t utils_hdf5_write_dataset(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id, const hsize_t *start, const hsize_t *count, const hsize_t *stride); */
 escdf_errno_t utils_hdf5_write_dataset(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id, const size_t *start, const size_t *count, const size_t *stride);
 
+/**
+ * Writes a buffer to the union of several disjoint hyperslices of a dataset, with a single write operation. See
+ * utils_hdf5_read_dataset_boxes() for the description of the boxes and of the buffer ordering.
+ *
+ * @param[in] dtset_id: identifier of the dataset to write to.
+ * @param[in] xfer_id: identifier of a transfer property list for this I/O operation.
+ * @param[in] buf: data to be written.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[in] nboxes: number of boxes.
+ * @param[in] start: offsets of start of each box, nboxes times the rank of the dataset.
+ * @param[in] count: number of blocks included in each box.
+ * @param[in] stride: stride of each box, may be NULL.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_write_dataset_boxes(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id,
+                                             size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride);
+
+/**
+ * Writes a hyperslice of a larger memory buffer to a hyperslice of a dataset. See utils_hdf5_read_dataset_mem() for
+ * the description of the memory selection.
+ *
+ * @param[in] dtset_id: identifier of the dataset to write to.
+ * @param[in] xfer_id: identifier of a transfer property list for this I/O operation.
+ * @param[in] buf: data to be written.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[in] start: offset of start of hyperslab on disk.
+ * @param[in] count: number of blocks included in hyperslab on disk.
+ * @param[in] stride: hyperslab stride on disk.
+ * @param[in] mem_dims: shape of the memory buffer.
+ * @param[in] mem_ndims: number of dimensions of the memory buffer.
+ * @param[in] mem_start: offset of start of hyperslab in memory.
+ * @param[in] mem_count: number of blocks included in hyperslab in memory.
+ * @param[in] mem_stride: hyperslab stride in memory.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_write_dataset_mem(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id,
+                                           const hsize_t *start, const hsize_t *count, const hsize_t *stride,
+                                           const hsize_t *mem_dims, unsigned int mem_ndims,
+                                           const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride);
+
+
+/**
+ * Extends a dataset of frames by one frame and writes buf into it.
+ *
+ * @param[in] dtset_id: dataset identifier, created with utils_hdf5_create_dataset_frames().
+ * @param[in] xfer_id: identifier of the transfer property list.
+ * @param[in] buf: data of one frame.
+ * @param[in] mem_type_id: identifier of the memory datatype.
+ * @param[out] frame: if not NULL, the index of the new frame.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_append_frame(hid_t dtset_id, hid_t xfer_id, const void *buf, hid_t mem_type_id, size_t *frame);
+
 
 /* The following functions are deprecated and should be removed */
 /*
@@ -384,6 +548,16 @@ escdf_errno_t utils_hdf5_write_string_old(hid_t loc_id, const char *name, const
 
 escdf_errno_t utils_hdf5_open_dataset(hid_t loc_id, const char *name, hid_t *dtset_pt );
 
+#ifdef HAVE_MPI
+/**
+ * Open again the dataset dtset_id with independent metadata reads, for
+ * transfers done by a subset of the ranks while the file uses collective
+ * metadata operations. The returned identifier must be closed with
+ * utils_hdf5_close_dataset().
+ */
+escdf_errno_t utils_hdf5_open_dataset_independent(hid_t dtset_id, hid_t *dtset_pt);
+#endif
+
 escdf_errno_t utils_hdf5_open_group(hid_t loc_id, const char *path, hid_t *grouo_id );
 
 /******************************************************************************
@@ -413,6 +587,39 @@ escdf_errno_t utils_hdf5_close_dataset(hid_t dtset_id);
 /* OLD: escdf_errno_t utils_hdf5_select_slice(hid_t dtset_id, hid_t *diskspace_id, hid_t *memspace_id, const hsize_t *start, const hsize_t *count, const hsize_t *stride); */
 escdf_errno_t utils_hdf5_select_slice(hid_t dtset_id, hid_t *diskspace_id, hid_t *memspace_id, const size_t *start, const size_t *count, const size_t *stride);
 
+/**
+ * Selects the union of several disjoint hyperslab regions from a dataset. The memory dataspace is a flat array of the
+ * total number of selected elements.
+ *
+ * @param[in] dtset_id: dataset identifier.
+ * @param[out] diskspace_id: identifier for a copy of the dataspace on disk.
+ * @param[out] memspace_id: identifier of the dataspace in memory.
+ * @param[in] nboxes: number of boxes.
+ * @param[in] start: offsets of start of each box, nboxes times the rank of the dataset.
+ * @param[in] count: number of blocks included in each box.
+ * @param[in] stride: stride of each box, may be NULL.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_select_boxes(hid_t dtset_id, hid_t *diskspace_id, hid_t *memspace_id,
+                                      size_t nboxes, const hsize_t *start, const hsize_t *count, const hsize_t *stride);
+
+/**
+ * Creates a memory dataspace of shape mem_dims and selects a hyperslab region in it. If either mem_start or
+ * mem_count are NULL, the whole dataspace is selected. The number of selected elements must match npoints.
+ *
+ * @param[out] memspace_id: identifier of the dataspace in memory.
+ * @param[in] npoints: expected number of selected elements.
+ * @param[in] mem_dims: shape of the memory buffer.
+ * @param[in] mem_ndims: number of dimensions of the memory buffer.
+ * @param[in] mem_start: offset of start of hyperslab.
+ * @param[in] mem_count: number of blocks included in hyperslab.
+ * @param[in] mem_stride: hyperslab stride.
+ * @return error code.
+ */
+escdf_errno_t utils_hdf5_select_mem_slice(hid_t *memspace_id, hssize_t npoints,
+                                          const hsize_t *mem_dims, unsigned int mem_ndims,
+                                          const hsize_t *mem_start, const hsize_t *mem_count, const hsize_t *mem_stride);
+
 
 /**
  * @brief return the HDF5 memory data type for a given ESCDF datatype